@@ -0,0 +1,390 @@
+#pragma once
+
+#include <new>
+#include <span>
+#include <array>
+#include <tuple>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <concepts>
+#include <stdexcept>
+#include <type_traits>
+
+#include <cpputils/type_traits.hpp>
+#include <cpputils/utility.hpp>
+
+namespace cpputils {
+
+//! Set of component types of the entities of an archetype (order and duplicates are irrelevant)
+template<typename... Cs>
+struct archetype {};
+
+//! Components that the archetypes matched by a query must contain
+template<typename... Cs>
+struct with_components {};
+
+//! Components that the archetypes matched by a query must not contain
+template<typename... Cs>
+struct without_components {};
+
+
+#ifndef DOXYGEN
+namespace detail {
+
+    inline constexpr std::size_t archetype_chunk_size = 16*1024;
+    inline constexpr std::size_t archetype_chunk_alignment = 64;
+
+    // layout of the component columns within a chunk
+    template<typename... Cs>
+    struct chunk_layout {
+        static constexpr std::size_t aligned(std::size_t offset, std::size_t alignment) noexcept {
+            return (offset + alignment - 1)/alignment*alignment;
+        }
+
+        static constexpr std::size_t bytes_for(std::size_t rows) noexcept {
+            std::size_t end = 0;
+            (..., (end = aligned(end, alignof(Cs)) + rows*sizeof(Cs)));
+            return end;
+        }
+
+        static constexpr std::size_t capacity = [] () {
+            std::size_t rows = archetype_chunk_size/(sizeof(Cs) + ...);
+            while (rows > 0 && bytes_for(rows) > archetype_chunk_size)
+                --rows;
+            return rows;
+        }();
+
+        static constexpr std::array<std::size_t, sizeof...(Cs)> offsets = [] () {
+            std::array<std::size_t, sizeof...(Cs)> result{};
+            std::size_t end = 0, i = 0;
+            (..., (end = aligned(end, alignof(Cs)), result[i++] = end, end += capacity*sizeof(Cs)));
+            return result;
+        }();
+    };
+
+    struct chunk_deleter {
+        void operator()(std::byte* chunk) const noexcept {
+            ::operator delete(chunk, std::align_val_t{archetype_chunk_alignment});
+        }
+    };
+
+    // entities of one archetype, stored in chunks of archetype_chunk_size bytes with one column per component
+    template<typename... Cs>
+        requires((std::is_nothrow_move_constructible_v<Cs> and ...) and
+                 (std::is_nothrow_move_assignable_v<Cs> and ...) and
+                 (std::is_nothrow_destructible_v<Cs> and ...))
+    class chunked_storage {
+        using layout = chunk_layout<Cs...>;
+        static_assert(layout::capacity > 0, "The components of an archetype must fit into a chunk");
+        static_assert(((alignof(Cs) <= archetype_chunk_alignment) and ...),
+                      "The alignment of components must not exceed the alignment of chunks");
+
+     public:
+        static constexpr std::size_t chunk_capacity = layout::capacity;
+
+        template<typename C>
+        static constexpr bool contains = is_any_of_v<C, Cs...>;
+
+        chunked_storage() = default;
+        chunked_storage(const chunked_storage&) = delete;
+        chunked_storage(chunked_storage&& other) noexcept
+        : _chunks{std::move(other._chunks)}
+        , _size{std::exchange(other._size, 0)}
+        {}
+
+        ~chunked_storage() {
+            clear();
+        }
+
+        std::size_t size() const noexcept { return _size; }
+        std::size_t chunk_count() const noexcept { return (_size + chunk_capacity - 1)/chunk_capacity; }
+
+        //! Return the values of the given component in the given chunk
+        template<typename C>
+        std::span<C> column(std::size_t chunk) noexcept {
+            return {_column<C>(chunk), _rows_in(chunk)};
+        }
+
+        template<typename C>
+        std::span<const C> column(std::size_t chunk) const noexcept {
+            return {_column<C>(chunk), _rows_in(chunk)};
+        }
+
+        template<typename C>
+        C& get(std::size_t row) noexcept {
+            return _column<C>(row/chunk_capacity)[row%chunk_capacity];
+        }
+
+        template<typename C>
+        const C& get(std::size_t row) const noexcept {
+            return _column<C>(row/chunk_capacity)[row%chunk_capacity];
+        }
+
+        //! Append a row, constructing each column from the argument of the same (decayed) type
+        template<typename... Args>
+        std::size_t emplace(Args&&... args) {
+            if (_size == _chunks.size()*chunk_capacity)
+                _chunks.emplace_back(static_cast<std::byte*>(
+                    ::operator new(archetype_chunk_size, std::align_val_t{archetype_chunk_alignment})
+                ));
+
+            auto arguments = std::forward_as_tuple(std::forward<Args>(args)...);
+            const std::size_t row = _size;
+            std::size_t constructed = 0;
+            try {
+                (..., (::new (static_cast<void*>(&get<Cs>(row))) Cs(
+                    std::get<index_of<Cs, std::remove_cvref_t<Args>...>()>(std::move(arguments))
+                ), ++constructed));
+            } catch (...) {
+                std::size_t column = 0;
+                (..., (column++ < constructed ? get<Cs>(row).~Cs() : void()));
+                throw;
+            }
+            return _size++;
+        }
+
+        //! Remove the given row by moving the last row into it
+        void erase(std::size_t row) noexcept {
+            const std::size_t last = _size - 1;
+            (..., _move_row<Cs>(last, row));
+            _size = last;
+        }
+
+        void clear() noexcept {
+            while (_size > 0) {
+                --_size;
+                (..., get<Cs>(_size).~Cs());
+            }
+        }
+
+     private:
+        template<typename C, typename... Ts>
+        static constexpr std::size_t index_of() noexcept {
+            return cpputils::indexed<Ts...>{}.template index_of<C>().value;
+        }
+
+        std::size_t _rows_in(std::size_t chunk) const noexcept {
+            return std::min(chunk_capacity, _size - chunk*chunk_capacity);
+        }
+
+        template<typename C>
+        C* _column(std::size_t chunk) const noexcept {
+            return std::launder(reinterpret_cast<C*>(_chunks[chunk].get() + layout::offsets[index_of<C, Cs...>()]));
+        }
+
+        template<typename C>
+        void _move_row(std::size_t from, std::size_t to) noexcept {
+            if (from != to)
+                get<C>(to) = std::move(get<C>(from));
+            get<C>(from).~C();
+        }
+
+        std::vector<std::unique_ptr<std::byte, chunk_deleter>> _chunks;
+        std::size_t _size = 0;
+    };
+
+    template<typename A>
+    struct archetype_components;
+    template<typename... Cs>
+    struct archetype_components<archetype<Cs...>> : std::type_identity<type_list<Cs...>> {};
+    template<typename... Cs>
+    struct archetype_components<type_list<Cs...>> : std::type_identity<type_list<Cs...>> {};
+
+    template<typename L>
+    struct archetype_storage;
+    template<typename... Cs>
+    struct archetype_storage<type_list<Cs...>> : std::type_identity<chunked_storage<Cs...>> {};
+
+    template<typename T, typename L>
+    struct index_in;
+    template<typename T, typename... Ts>
+    struct index_in<T, type_list<Ts...>> : decltype(cpputils::indexed<Ts...>{}.template index_of<T>()) {};
+
+    template<typename L>
+    struct indexed_storages;
+    template<typename... As>
+    struct indexed_storages<type_list<As...>> {
+        using type = cpputils::indexed_tuple<typename archetype_storage<As>::type...>;
+        static type make() { return type{typename archetype_storage<As>::type{}...}; }
+    };
+
+    template<typename T, typename L>
+    struct list_contains;
+    template<typename T, typename... Ts>
+    struct list_contains<T, type_list<Ts...>> : std::disjunction<std::is_same<T, Ts>...> {};
+
+    template<typename With, typename Without>
+    struct archetype_query;
+    template<typename... With, typename... Without>
+    struct archetype_query<with_components<With...>, without_components<Without...>> {
+        template<typename A>
+        struct matches : std::bool_constant<
+            (list_contains<With, A>::value and ...) and !(list_contains<Without, A>::value or ...)
+        > {};
+    };
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+//! Storage of entities that are defined by their set of components, for a closed set of archetypes. The component
+//! sets are canonicalized (duplicates removed and sorted by the order of first occurrence over all archetypes), such
+//! that archetypes with the same components are identical. Each archetype stores its entities in chunks of 16 KiB,
+//! with one contiguous column per component in each chunk. Queries are resolved at compile time into the list of
+//! matching archetypes, and iterate over their chunks.
+template<typename... Archetypes> requires(sizeof...(Archetypes) > 0)
+class archetype_registry {
+    using all_components = unique_t<merged_t<type_list<>, typename detail::archetype_components<Archetypes>::type...>>;
+
+    template<typename C>
+    struct component_order : detail::index_in<C, all_components> {};
+
+    template<typename A>
+    using canonical_t = sorted_t<component_order, detail::less, unique_t<typename detail::archetype_components<A>::type>>;
+
+ public:
+    //! The canonical archetypes, given as lists of their components
+    using archetypes = unique_t<type_list<canonical_t<Archetypes>...>>;
+
+    //! The archetypes (given as lists of their components) that contain all With and none of the Without components
+    template<typename With, typename Without = without_components<>>
+    using matching_t = filtered_t<detail::archetype_query<With, Without>::template matches, archetypes>;
+
+    //! Handle to an entity, which stays valid until an entity of the same archetype is destroyed
+    struct entity {
+        std::size_t archetype_index;
+        std::size_t row;
+    };
+
+    //! Number of entities that fit into one chunk of the given archetype
+    template<typename A>
+    static constexpr std::size_t chunk_capacity = detail::archetype_storage<canonical_t<A>>::type::chunk_capacity;
+
+    //! Return the index of the given archetype (given as archetype<...> or type_list<...>, in any order)
+    template<typename A>
+    static constexpr auto index_of() noexcept {
+        return index_constant<detail::index_in<canonical_t<A>, archetypes>::value>{};
+    }
+
+    archetype_registry() : _storages{detail::indexed_storages<archetypes>::make()} {}
+    archetype_registry(const archetype_registry&) = delete;
+    archetype_registry& operator=(const archetype_registry&) = delete;
+
+    //! Create an entity with the given components (in any order), whose archetype must be registered
+    template<typename... Components>
+        requires(detail::list_contains<canonical_t<archetype<std::remove_cvref_t<Components>...>>, archetypes>::value and
+                 are_unique_v<std::remove_cvref_t<Components>...>)
+    entity create(Components&&... components) {
+        constexpr auto index = index_of<archetype<std::remove_cvref_t<Components>...>>();
+        return {index.value, _storages.get(index).emplace(std::forward<Components>(components)...)};
+    }
+
+    //! Destroy the given entity, moving the last entity of the same archetype into its place
+    void destroy(const entity& e) noexcept {
+        _visit(*this, e.archetype_index, [&] (auto& storage) { storage.erase(e.row); });
+    }
+
+    //! Return a pointer to the given component of the given entity, or nullptr if its archetype does not contain it
+    template<typename C>
+    C* get_if(const entity& e) noexcept {
+        return _get_if<C>(*this, e);
+    }
+
+    template<typename C>
+    const C* get_if(const entity& e) const noexcept {
+        return _get_if<C>(*this, e);
+    }
+
+    //! Return the given component of the given entity (throws std::out_of_range if its archetype does not contain it)
+    template<typename C>
+    C& get(const entity& e) {
+        return _get<C>(*this, e);
+    }
+
+    template<typename C>
+    const C& get(const entity& e) const {
+        return _get<C>(*this, e);
+    }
+
+    //! Return the number of entities of the given archetype
+    template<typename A>
+    std::size_t size() const noexcept {
+        return _storages.get(index_of<A>()).size();
+    }
+
+    //! Return the total number of entities
+    std::size_t size() const noexcept {
+        std::size_t result = 0;
+        cpputils::for_each(_storages, [&] (const auto& storage) { result += storage.size(); });
+        return result;
+    }
+
+    //! Return the number of chunks used by the given archetype
+    template<typename A>
+    std::size_t chunk_count() const noexcept {
+        return _storages.get(index_of<A>()).chunk_count();
+    }
+
+    //! Invoke the given action with spans over the With components (in the given order) of each chunk of
+    //! all archetypes that contain all With and none of the Without components
+    template<typename With, typename Without = without_components<>, typename Action>
+    void for_each_chunk(Action&& action) {
+        _for_each_matching_chunk(with_list<With>{}, matching_t<With, Without>{}, action);
+    }
+
+    //! Invoke the given action with references to the With components (in the given order) of all entities
+    //! of all archetypes that contain all With and none of the Without components
+    template<typename With, typename Without = without_components<>, typename Action>
+    void for_each(Action&& action) {
+        for_each_chunk<With, Without>([&] <typename... Cs> (std::span<Cs>... columns) {
+            std::size_t rows = 0;
+            (..., (rows = columns.size()));
+            for (std::size_t row = 0; row < rows; ++row)
+                action(columns[row]...);
+        });
+    }
+
+ private:
+    template<typename W>
+    struct with_list;
+    template<typename... Cs>
+    struct with_list<with_components<Cs...>> : type_list<Cs...> {};
+
+    template<typename... With, typename... Matching, typename Action>
+    void _for_each_matching_chunk(const type_list<With...>&, const type_list<Matching...>&, Action& action) {
+        (..., [&] (auto& storage) {
+            for (std::size_t chunk = 0; chunk < storage.chunk_count(); ++chunk)
+                action(storage.template column<With>(chunk)...);
+        }(_storages.get(index_of<Matching>())));
+    }
+
+    template<typename C, typename Self>
+    static auto* _get_if(Self& self, const entity& e) noexcept {
+        using result = std::conditional_t<std::is_const_v<Self>, const C*, C*>;
+        return _visit(self, e.archetype_index, [&] (auto& storage) -> result {
+            if constexpr (std::remove_cvref_t<decltype(storage)>::template contains<C>)
+                return &storage.template get<C>(e.row);
+            else
+                return nullptr;
+        });
+    }
+
+    template<typename C, typename Self>
+    static auto& _get(Self& self, const entity& e) {
+        if (auto* component = _get_if<C>(self, e))
+            return *component;
+        throw std::out_of_range("Entity does not have the requested component");
+    }
+
+    template<typename Self, typename Action>
+    static decltype(auto) _visit(Self& self, std::size_t archetype_index, Action&& action) {
+        return with_index<archetypes::size>(archetype_index, [&] (auto index) -> decltype(auto) {
+            return action(self._storages.get(index));
+        });
+    }
+
+    typename detail::indexed_storages<archetypes>::type _storages;
+};
+
+}  // namespace cpputils
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <new>
+#include <bit>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <optional>
+#include <algorithm>
+#include <type_traits>
+
+#include <cpputils/type_traits.hpp>
+#include <cpputils/utility.hpp>
+
+namespace cpputils {
+
+#ifndef DOXYGEN
+namespace detail {
+
+    inline std::atomic<std::uint64_t> next_typed_channels_id{1};
+
+    // Bounded lock-free ring buffer for a single producer and multiple consumers. Each slot carries a sequence
+    // number that tells whether it is ready to be written (== position) or read (== position + 1), such that
+    // consumers only contend on the head index, and the producer never waits for consumers that are not done.
+    template<typename T>
+    class spmc_ring {
+        struct slot {
+            std::atomic<std::size_t> sequence;
+            alignas(T) std::byte storage[sizeof(T)];
+        };
+
+     public:
+        explicit spmc_ring(std::size_t capacity)
+        : _mask{std::bit_ceil(std::max(capacity, std::size_t{2})) - 1}
+        , _slots{std::make_unique<slot[]>(_mask + 1)} {
+            for (std::size_t i = 0; i <= _mask; ++i)
+                _slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        spmc_ring(const spmc_ring&) = delete;
+
+        spmc_ring(spmc_ring&& other) noexcept
+        : _head{other._head.load(std::memory_order_relaxed)}
+        , _tail{other._tail.load(std::memory_order_relaxed)}
+        , _mask{other._mask}
+        , _slots{std::move(other._slots)}
+        {}
+
+        ~spmc_ring() {
+            if (_slots)
+                while (try_pop()) {}
+        }
+
+        std::size_t capacity() const noexcept { return _mask + 1; }
+
+        //! Return the number of messages in the buffer (only a snapshot if there are concurrent operations)
+        std::size_t size() const noexcept {
+            const std::size_t head = _head.load(std::memory_order_relaxed);
+            const std::size_t tail = _tail.load(std::memory_order_relaxed);
+            return tail > head ? tail - head : 0;
+        }
+
+        // must only be called by one thread at a time
+        template<typename U>
+        bool try_push(U&& value) noexcept(std::is_nothrow_constructible_v<T, U>) {
+            const std::size_t position = _tail.load(std::memory_order_relaxed);
+            slot& s = _slots[position & _mask];
+            if (s.sequence.load(std::memory_order_acquire) != position)
+                return false;
+            ::new (static_cast<void*>(s.storage)) T(std::forward<U>(value));
+            s.sequence.store(position + 1, std::memory_order_release);
+            _tail.store(position + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        std::optional<T> try_pop() noexcept {
+            std::size_t position = _head.load(std::memory_order_relaxed);
+            slot* s;
+            while (true) {
+                s = &_slots[position & _mask];
+                const std::size_t sequence = s->sequence.load(std::memory_order_acquire);
+                const auto difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+                if (difference == 0) {
+                    if (_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        break;
+                } else if (difference < 0)
+                    return std::nullopt;
+                else
+                    position = _head.load(std::memory_order_relaxed);
+            }
+            T* value = std::launder(reinterpret_cast<T*>(s->storage));
+            std::optional<T> result{std::move(*value)};
+            value->~T();
+            s->sequence.store(position + _mask + 1, std::memory_order_release);
+            return result;
+        }
+
+     private:
+        alignas(cache_line_size) std::atomic<std::size_t> _head{0};
+        alignas(cache_line_size) std::atomic<std::size_t> _tail{0};
+        alignas(cache_line_size) std::size_t _mask;
+        std::unique_ptr<slot[]> _slots;
+    };
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+//! Message channels for a closed set of message types, with one bounded lock-free ring buffer per type. Messages
+//! of each type must be pushed by a single producer thread at a time (different types may have different
+//! producers), and can be consumed by any number of threads, either per type or round-robin across all types.
+template<typename... Ts>
+    requires(are_unique_v<Ts...> and sizeof...(Ts) > 0 and (std::is_nothrow_move_constructible_v<Ts> and ...))
+class typed_channels {
+ public:
+    //! Create channels that can hold (at least) the given number of messages per type (rounded to a power of two)
+    explicit typed_channels(std::size_t capacity_per_type = 1024)
+    : _rings{detail::spmc_ring<Ts>{capacity_per_type}...}
+    {}
+
+    typed_channels(const typed_channels&) = delete;
+    typed_channels& operator=(const typed_channels&) = delete;
+
+    //! Return the index of the channel for the given message type
+    template<typename T>
+    static constexpr auto index_of() noexcept {
+        return indexed<Ts...>{}.template index_of<T>();
+    }
+
+    //! Push the given message into the channel of its type, returning false if the channel is full
+    template<typename T> requires(contains_decayed_v<T, Ts...>)
+    bool try_push(T&& message) {
+        return _ring<std::decay_t<T>>().try_push(std::forward<T>(message));
+    }
+
+    //! Push the given message into the channel of its type, yielding while the channel is full
+    template<typename T> requires(contains_decayed_v<T, Ts...>)
+    void push(T&& message) {
+        auto& ring = _ring<std::decay_t<T>>();
+        while (!ring.try_push(std::forward<T>(message)))
+            std::this_thread::yield();
+    }
+
+    //! Pop a message of the given type, if there is one
+    template<typename T> requires(is_any_of_v<T, Ts...>)
+    std::optional<T> try_pop() noexcept {
+        return _ring<T>().try_pop();
+    }
+
+    //! Pop a message of any type and invoke the given action with it (as rvalue). The types are tried round-robin,
+    //! starting after the type of the message most recently polled from these channels by the calling thread.
+    //! Returns false if all channels were empty.
+    template<typename Action>
+    bool poll(Action&& action) {
+        std::size_t& next = _local_cursor();
+        for (std::size_t k = 0; k < sizeof...(Ts); ++k) {
+            const std::size_t i = (next + k)%sizeof...(Ts);
+            const bool found = with_index<sizeof...(Ts)>(i, [&] (auto index) {
+                auto message = _rings.get(index).try_pop();
+                if (message)
+                    action(std::move(*message));
+                return message.has_value();
+            });
+            if (found) {
+                next = i + 1;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //! Return the number of queued messages of the given type (a snapshot if there are concurrent operations)
+    template<typename T> requires(is_any_of_v<T, Ts...>)
+    std::size_t size() const noexcept {
+        return _rings.get(index_of<T>()).size();
+    }
+
+    //! Return the number of messages of each type that fit into the channels
+    std::size_t capacity_per_type() const noexcept {
+        return _rings.get(ic<0>).capacity();
+    }
+
+ private:
+    template<typename T>
+    detail::spmc_ring<T>& _ring() noexcept {
+        return _rings.get(index_of<T>());
+    }
+
+    // channels whose cursors collide in the cache restart at the first type
+    std::size_t& _local_cursor() noexcept {
+        thread_local detail::instance_cache<std::size_t> cursors;
+        return cursors.get(_id, [] () noexcept { return std::size_t{0}; });
+    }
+
+    const std::uint64_t _id = detail::next_typed_channels_id.fetch_add(1, std::memory_order_relaxed);
+    indexed_tuple<detail::spmc_ring<Ts>...> _rings;
+};
+
+}  // namespace cpputils
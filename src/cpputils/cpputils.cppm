@@ -0,0 +1,155 @@
+// Module interface of cpputils (`import cpputils;`), which exports the contents of all headers.
+// The headers are included in the global module fragment, such that the module and the headers
+// can be used side by side in the same program.
+module;
+
+#include <cpputils/type_traits.hpp>
+#include <cpputils/utility.hpp>
+#include <cpputils/ostream.hpp>
+#include <cpputils/format.hpp>
+#include <cpputils/numeric.hpp>
+#include <cpputils/soa_vector.hpp>
+#include <cpputils/type_collection.hpp>
+#include <cpputils/parallel.hpp>
+#include <cpputils/serialization.hpp>
+#include <cpputils/memory.hpp>
+#include <cpputils/variant.hpp>
+#include <cpputils/archetypes.hpp>
+#include <cpputils/channels.hpp>
+#include <cpputils/metrics.hpp>
+#include <cpputils/expressions.hpp>
+#include <cpputils/type_name.hpp>
+
+export module cpputils;
+
+export namespace cpputils {
+
+// type_traits.hpp
+using cpputils::index_constant;
+using cpputils::ic;
+using cpputils::is_equal;
+using cpputils::is_less;
+using cpputils::decayed_trait;
+using cpputils::type_list;
+using cpputils::first;
+using cpputils::first_t;
+using cpputils::is_complete;
+using cpputils::is_complete_v;
+using cpputils::is_any_of;
+using cpputils::is_any_of_v;
+using cpputils::contains_decayed;
+using cpputils::contains_decayed_v;
+using cpputils::type_list_at;
+using cpputils::type_list_at_t;
+using cpputils::are_unique;
+using cpputils::are_unique_v;
+using cpputils::first_duplicate;
+using cpputils::first_duplicate_t;
+using cpputils::unique;
+using cpputils::unique_t;
+using cpputils::merged;
+using cpputils::merged_t;
+using cpputils::filtered;
+using cpputils::filtered_t;
+using cpputils::sorted;
+using cpputils::sorted_t;
+using cpputils::trait_table;
+
+// utility.hpp
+using cpputils::value_or_reference;
+using cpputils::inplace_function;
+using cpputils::function_ref;
+using cpputils::indexed;
+using cpputils::indexed_tuple;
+using cpputils::packed_indexed_tuple;
+using cpputils::is_indexed_tuple;
+using cpputils::is_indexed_tuple_v;
+using cpputils::with_index;
+using cpputils::static_for;
+using cpputils::visit;
+using cpputils::for_each;
+using cpputils::transform;
+using cpputils::values;
+using cpputils::set_union;
+using cpputils::set_intersection;
+using cpputils::set_difference;
+using cpputils::unrolled_for;
+
+// ostream.hpp
+using cpputils::operator<<;
+
+// numeric.hpp
+using cpputils::arithmetic_range;
+using cpputils::sum;
+using cpputils::min;
+using cpputils::max;
+using cpputils::dot;
+using cpputils::inclusive_scan;
+using cpputils::stencil_apply;
+
+// soa_vector.hpp
+using cpputils::soa_vector;
+
+// type_collection.hpp
+using cpputils::type_collection;
+
+// parallel.hpp
+using cpputils::executor;
+using cpputils::sized_executor;
+using cpputils::thread_pool;
+using cpputils::parallel_for_each;
+
+// serialization.hpp
+using cpputils::serializer;
+using cpputils::serializable;
+using cpputils::schema_mismatch;
+using cpputils::schema_hash;
+using cpputils::serialized_size;
+using cpputils::serialize;
+using cpputils::deserialize;
+
+// memory.hpp
+using cpputils::arena;
+using cpputils::pool;
+using cpputils::typed_pools;
+
+// variant.hpp
+using cpputils::bad_variant_access;
+using cpputils::variant;
+using cpputils::is_variant;
+using cpputils::is_variant_v;
+
+// archetypes.hpp
+using cpputils::archetype;
+using cpputils::with_components;
+using cpputils::without_components;
+using cpputils::archetype_registry;
+
+// channels.hpp
+using cpputils::typed_channels;
+
+// metrics.hpp
+using cpputils::type_statistics;
+using cpputils::type_metrics;
+using cpputils::write_json;
+
+// expressions.hpp
+using cpputils::expression;
+using cpputils::is_expression;
+using cpputils::is_expression_v;
+using cpputils::lazy;
+using cpputils::lazy_fields;
+using cpputils::evaluate;
+using cpputils::operator+;
+using cpputils::operator-;
+using cpputils::operator*;
+using cpputils::operator/;
+
+// type_name.hpp
+using cpputils::fnv1a_hash;
+using cpputils::fixed_string;
+using cpputils::type_name;
+using cpputils::type_id;
+using cpputils::type_names;
+
+}  // namespace cpputils
@@ -0,0 +1,317 @@
+#pragma once
+
+#include <latch>
+#include <atomic>
+#include <vector>
+#include <ranges>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#include <cpputils/utility.hpp>
+#include <cpputils/numeric.hpp>
+#include <cpputils/parallel.hpp>
+
+namespace cpputils {
+
+//! Lazily evaluated element-wise expression over arrays (see lazy). Combining expressions (and scalars) with the
+//! arithmetic operators builds up a new expression without computing anything; the elements are only computed
+//! when the expression is evaluated, in a single loop over all operands.
+template<typename Node>
+class expression;
+
+//! Type trait to check if a type is a cpputils::expression
+template<typename T>
+struct is_expression : std::false_type {};
+template<typename Node>
+struct is_expression<expression<Node>> : std::true_type {};
+template<typename T>
+inline constexpr bool is_expression_v = is_expression<T>::value;
+
+#ifndef DOXYGEN
+namespace detail {
+
+    // number of elements evaluated per chunk, which is the unit of work distributed across threads
+    inline constexpr std::size_t expression_chunk_size = std::size_t{1} << 14;
+
+    // expressions with fewer elements are always evaluated on the calling thread
+    inline constexpr std::size_t expression_parallel_threshold = 4*expression_chunk_size;
+
+    template<typename T>
+    concept expression_operand = is_expression_v<std::remove_cvref_t<T>>
+        or std::is_arithmetic_v<std::remove_cvref_t<T>>
+        or arithmetic_range<std::remove_cvref_t<T>>;
+
+    // scalars are stored by value, (sub-)expressions like the arrays of leaves (borrowed if given as lvalue)
+    template<typename T>
+    using stored_operand_t = std::conditional_t<std::is_arithmetic_v<std::remove_cvref_t<T>>, std::remove_cvref_t<T>, T>;
+
+    template<typename T>
+    constexpr decltype(auto) element_of(const T& operand, std::size_t i) noexcept {
+        if constexpr (std::is_arithmetic_v<T>)
+            return operand;
+        else
+            return operand[i];
+    }
+
+    struct add { constexpr auto operator()(const auto& a, const auto& b) const noexcept { return a + b; } };
+    struct subtract { constexpr auto operator()(const auto& a, const auto& b) const noexcept { return a - b; } };
+    struct multiply { constexpr auto operator()(const auto& a, const auto& b) const noexcept { return a*b; } };
+    struct divide { constexpr auto operator()(const auto& a, const auto& b) const noexcept { return a/b; } };
+    struct negate { constexpr auto operator()(const auto& a) const noexcept { return -a; } };
+
+    template<typename R>
+    class leaf_node {
+     public:
+        constexpr explicit leaf_node(R&& range) noexcept
+        : _range{std::forward<R>(range)}
+        {}
+
+        constexpr std::size_t size() const noexcept { return std::ranges::size(_range.get()); }
+        constexpr decltype(auto) operator[](std::size_t i) const noexcept { return std::ranges::data(_range.get())[i]; }
+
+     private:
+        value_or_reference<R> _range;
+    };
+
+    template<typename Op, typename E>
+    class unary_node {
+     public:
+        constexpr explicit unary_node(E&& operand) noexcept
+        : _operand{std::forward<E>(operand)}
+        {}
+
+        constexpr std::size_t size() const noexcept { return _operand.get().size(); }
+        constexpr auto operator[](std::size_t i) const noexcept { return Op{}(_operand.get()[i]); }
+
+     private:
+        value_or_reference<E> _operand;
+    };
+
+    template<typename Op, typename L, typename R>
+    class binary_node {
+        static constexpr bool scalar_lhs = std::is_arithmetic_v<std::remove_cvref_t<L>>;
+        static constexpr bool scalar_rhs = std::is_arithmetic_v<std::remove_cvref_t<R>>;
+
+     public:
+        template<typename A, typename B>
+        constexpr binary_node(A&& lhs, B&& rhs)
+        : _lhs{std::forward<A>(lhs)}
+        , _rhs{std::forward<B>(rhs)} {
+            if constexpr (!scalar_lhs and !scalar_rhs)
+                if (_lhs.get().size() != _rhs.get().size())
+                    throw std::invalid_argument("Operands of an expression must have the same size");
+        }
+
+        constexpr std::size_t size() const noexcept {
+            if constexpr (scalar_lhs)
+                return _rhs.get().size();
+            else
+                return _lhs.get().size();
+        }
+
+        constexpr auto operator[](std::size_t i) const noexcept {
+            return Op{}(element_of(_lhs.get(), i), element_of(_rhs.get(), i));
+        }
+
+     private:
+        value_or_reference<L> _lhs;
+        value_or_reference<R> _rhs;
+    };
+
+    template<typename A, typename B>
+    concept expression_operands = expression_operand<A> and expression_operand<B>
+        and (is_expression_v<std::remove_cvref_t<A>> or is_expression_v<std::remove_cvref_t<B>>);
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+template<typename Node>
+class expression {
+ public:
+    using value_type = std::remove_cvref_t<decltype(std::declval<const Node&>()[0])>;
+
+    constexpr explicit expression(Node node) noexcept(std::is_nothrow_move_constructible_v<Node>)
+    : _node{std::move(node)}
+    {}
+
+    //! Return the number of elements
+    constexpr std::size_t size() const noexcept { return _node.size(); }
+
+    //! Compute the element at the given index (only this one)
+    constexpr value_type operator[](std::size_t i) const noexcept { return _node[i]; }
+
+ private:
+    Node _node;
+};
+
+//! Create an expression with the elements of the given contiguous range of arithmetic values. The range is borrowed
+//! if given as lvalue (and must outlive the expression) and owned otherwise. The same holds for expressions used as
+//! operands of other expressions: named expressions are referenced, temporary ones are moved into the new one.
+template<typename R> requires(arithmetic_range<std::remove_cvref_t<R>>)
+constexpr auto lazy(R&& range) {
+    using node = detail::leaf_node<R>;
+    return expression<node>{node{std::forward<R>(range)}};
+}
+
+//! Return an indexed_tuple with one expression per element of the given indexed_tuple of arrays, which borrow them
+template<typename Tuple> requires(is_indexed_tuple_v<std::remove_const_t<Tuple>>)
+constexpr auto lazy_fields(Tuple& tuple) {
+    return [&] <std::size_t... i> (const std::index_sequence<i...>&) {
+        return indexed_tuple{lazy(tuple.get(ic<i>))...};
+    }(std::make_index_sequence<std::remove_const_t<Tuple>::size>{});
+}
+
+#ifndef DOXYGEN
+namespace detail {
+
+    // arrays used as operands are wrapped into a leaf expression
+    template<typename T>
+    constexpr decltype(auto) as_operand(T&& operand) {
+        if constexpr (arithmetic_range<std::remove_cvref_t<T>>)
+            return lazy(std::forward<T>(operand));
+        else
+            return std::forward<T>(operand);
+    }
+
+    template<typename Op, typename A, typename B>
+    constexpr auto make_binary_expression(A&& a, B&& b) {
+        using L = stored_operand_t<decltype(as_operand(std::forward<A>(a)))>;
+        using R = stored_operand_t<decltype(as_operand(std::forward<B>(b)))>;
+        using node = binary_node<Op, L, R>;
+        return expression<node>{node{as_operand(std::forward<A>(a)), as_operand(std::forward<B>(b))}};
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+//! Element-wise arithmetic on expressions, scalars and arrays (at least one operand must be an expression)
+template<typename A, typename B> requires(detail::expression_operands<A, B>)
+constexpr auto operator+(A&& a, B&& b) {
+    return detail::make_binary_expression<detail::add>(std::forward<A>(a), std::forward<B>(b));
+}
+
+template<typename A, typename B> requires(detail::expression_operands<A, B>)
+constexpr auto operator-(A&& a, B&& b) {
+    return detail::make_binary_expression<detail::subtract>(std::forward<A>(a), std::forward<B>(b));
+}
+
+template<typename A, typename B> requires(detail::expression_operands<A, B>)
+constexpr auto operator*(A&& a, B&& b) {
+    return detail::make_binary_expression<detail::multiply>(std::forward<A>(a), std::forward<B>(b));
+}
+
+template<typename A, typename B> requires(detail::expression_operands<A, B>)
+constexpr auto operator/(A&& a, B&& b) {
+    return detail::make_binary_expression<detail::divide>(std::forward<A>(a), std::forward<B>(b));
+}
+
+template<typename E> requires(is_expression_v<std::remove_cvref_t<E>>)
+constexpr auto operator-(E&& e) {
+    using node = detail::unary_node<detail::negate, E>;
+    return expression<node>{node{std::forward<E>(e)}};
+}
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename Node, typename T>
+    void evaluate_chunk(const expression<Node>& e, T* out, std::size_t chunk) noexcept {
+        const std::size_t end = std::min(e.size(), (chunk + 1)*expression_chunk_size);
+        for (std::size_t i = chunk*expression_chunk_size; i < end; ++i)
+            out[i] = static_cast<T>(e[i]);
+    }
+
+    template<typename Node, typename T>
+    void evaluate_into(const expression<Node>& e, T* out) noexcept {
+        const std::size_t chunks = (e.size() + expression_chunk_size - 1)/expression_chunk_size;
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+            evaluate_chunk(e, out, chunk);
+    }
+
+    template<typename Out, typename Node>
+    auto* checked_output(Out& out, const expression<Node>& e) {
+        if (std::ranges::size(out) != e.size())
+            throw std::invalid_argument("The output range must have the same size as the expression");
+        return std::ranges::data(out);
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+//! Evaluate the given expression into the given contiguous range of the same size, in a single loop. The output
+//! may be one of the arrays used in the expression.
+template<typename Node, typename Out> requires(arithmetic_range<std::remove_cvref_t<Out>>)
+void evaluate(const expression<Node>& e, Out&& out) {
+    detail::evaluate_into(e, detail::checked_output(out, e));
+}
+
+//! Evaluate the given expression into the given contiguous range of the same size. Large expressions are split into
+//! cache-sized chunks, which are evaluated concurrently by the calling thread and up to `parallelism` tasks submitted
+//! to the executor. If submitting a task throws, the remaining chunks are evaluated before the exception is rethrown.
+//! Note: must not be called from within a task of an executor that may not have idle threads left.
+template<typename Node, typename Out, executor Executor> requires(arithmetic_range<std::remove_cvref_t<Out>>)
+void evaluate(const expression<Node>& e, Out&& out, Executor& executor, std::size_t parallelism) {
+    auto* data = detail::checked_output(out, e);
+    if (e.size() < detail::expression_parallel_threshold)
+        return detail::evaluate_into(e, data);
+
+    const std::size_t chunks = (e.size() + detail::expression_chunk_size - 1)/detail::expression_chunk_size;
+    const std::size_t tasks = std::min(chunks - 1, parallelism);
+    std::atomic<std::size_t> next_chunk{0};
+    std::latch done{static_cast<std::ptrdiff_t>(tasks)};
+    const auto work = [&] () noexcept {
+        for (std::size_t chunk = next_chunk++; chunk < chunks; chunk = next_chunk++)
+            detail::evaluate_chunk(e, data, chunk);
+    };
+
+    std::size_t submitted = 0;
+    try {
+        for (; submitted < tasks; ++submitted)
+            executor.execute([&] () noexcept { work(); done.count_down(); });
+    } catch (...) {
+        // the submitted tasks reference the locals, so they must finish before unwinding
+        done.count_down(static_cast<std::ptrdiff_t>(tasks - submitted));
+        work();
+        done.wait();
+        throw;
+    }
+    work();
+    done.wait();
+}
+
+//! Evaluate the given expression into the given contiguous range of the same size, with as many concurrent tasks as
+//! the executor has threads
+template<typename Node, typename Out, sized_executor Executor> requires(arithmetic_range<std::remove_cvref_t<Out>>)
+void evaluate(const expression<Node>& e, Out&& out, Executor& executor) {
+    evaluate(e, std::forward<Out>(out), executor, executor.size());
+}
+
+//! Evaluate the given expression into a new vector
+template<typename Node>
+std::vector<typename expression<Node>::value_type> evaluate(const expression<Node>& e) {
+    std::vector<typename expression<Node>::value_type> result(e.size());
+    evaluate(e, result);
+    return result;
+}
+
+//! Evaluate the given expression into a new vector, using up to `parallelism` tasks of the given executor for large
+//! expressions
+template<typename Node, executor Executor>
+std::vector<typename expression<Node>::value_type> evaluate(const expression<Node>& e,
+                                                            Executor& executor,
+                                                            std::size_t parallelism) {
+    std::vector<typename expression<Node>::value_type> result(e.size());
+    evaluate(e, result, executor, parallelism);
+    return result;
+}
+
+//! Evaluate the given expression into a new vector, using the threads of the given executor for large expressions
+template<typename Node, sized_executor Executor>
+std::vector<typename expression<Node>::value_type> evaluate(const expression<Node>& e, Executor& executor) {
+    return evaluate(e, executor, executor.size());
+}
+
+}  // namespace cpputils
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cpputils/utility.hpp>
+
+#if __has_include(<format>)
+#include <format>
+#endif
+
+#if defined(__cpp_lib_format)
+
+#ifndef DOXYGEN
+namespace cpputils::detail {
+
+    //! Base for formatters of types that do not support format specifications
+    struct formatter_without_spec {
+        template<typename ParseContext>
+        constexpr typename ParseContext::iterator parse(ParseContext& ctx) {
+            if (ctx.begin() != ctx.end() && *ctx.begin() != '}')
+                throw std::format_error("cpputils formatters do not support format specifications");
+            return ctx.begin();
+        }
+    };
+
+    template<typename Tuple, typename FormatContext>
+    typename FormatContext::iterator format_tuple(const Tuple& tuple, FormatContext& ctx) {
+        auto out = ctx.out();
+        *out++ = '(';
+        bool is_first = true;
+        for_each(tuple, [&] (const auto& element) {
+            if (!std::exchange(is_first, false)) {
+                *out++ = ',';
+                *out++ = ' ';
+            }
+            out = std::format_to(out, "{}", element);
+        });
+        *out++ = ')';
+        return out;
+    }
+
+}  // namespace cpputils::detail
+#endif  // DOXYGEN
+
+//! Formats value lists as comma-separated values (e.g. "1, 2, 3"), without allocating
+template<auto... v>
+struct std::formatter<cpputils::values<v...>, char> : cpputils::detail::formatter_without_spec {
+    template<typename FormatContext>
+    typename FormatContext::iterator format(const cpputils::values<v...>& values, FormatContext& ctx) const {
+        return values.write_to(ctx.out());
+    }
+};
+
+//! Formats indexed tuples as parenthesized list of their elements (e.g. "(1, abc)")
+template<typename... Ts>
+struct std::formatter<cpputils::indexed_tuple<Ts...>, char> : cpputils::detail::formatter_without_spec {
+    template<typename FormatContext>
+    typename FormatContext::iterator format(const cpputils::indexed_tuple<Ts...>& tuple, FormatContext& ctx) const {
+        return cpputils::detail::format_tuple(tuple, ctx);
+    }
+};
+
+//! Formats packed indexed tuples as parenthesized list of their elements (e.g. "(1, abc)")
+template<typename... Ts>
+struct std::formatter<cpputils::packed_indexed_tuple<Ts...>, char> : cpputils::detail::formatter_without_spec {
+    template<typename FormatContext>
+    typename FormatContext::iterator format(const cpputils::packed_indexed_tuple<Ts...>& tuple, FormatContext& ctx) const {
+        return cpputils::detail::format_tuple(tuple, ctx);
+    }
+};
+
+#endif  // __cpp_lib_format
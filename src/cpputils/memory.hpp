@@ -0,0 +1,407 @@
+#pragma once
+
+#include <new>
+#include <bit>
+#include <span>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <memory_resource>
+
+#include <cpputils/type_traits.hpp>
+#include <cpputils/utility.hpp>
+
+namespace cpputils {
+
+#ifndef DOXYGEN
+namespace detail {
+
+    inline std::byte* align_up(std::byte* p, std::size_t alignment) noexcept {
+        const auto address = reinterpret_cast<std::uintptr_t>(p);
+        return p + ((alignment - address%alignment)%alignment);
+    }
+
+    // intrusive singly-linked list of free memory blocks
+    struct free_list {
+        struct node { node* next; };
+
+        void push(void* block) noexcept {
+            head = ::new (block) node{head};
+            ++size;
+        }
+
+        void* pop() noexcept {
+            node* block = head;
+            head = block->next;
+            --size;
+            return block;
+        }
+
+        node* head = nullptr;
+        std::size_t size = 0;
+    };
+
+    // header in front of each block of memory requested from the upstream resource
+    struct upstream_block {
+        upstream_block* previous;
+        std::size_t size;
+    };
+
+    inline void release_upstream_blocks(upstream_block*& last,
+                                        std::pmr::memory_resource* upstream,
+                                        std::size_t alignment = alignof(std::max_align_t)) noexcept {
+        while (last) {
+            upstream_block* previous = last->previous;
+            upstream->deallocate(last, last->size, alignment);
+            last = previous;
+        }
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+//! Monotonic (bump) allocator, which hands out memory from an optional initial buffer and from blocks of growing
+//! size requested from an upstream resource. Deallocation is a no-op, all memory is freed at once via release().
+class arena : public std::pmr::memory_resource {
+ public:
+    explicit arena(std::size_t initial_block_size = 4096,
+                   std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+    : _initial_block_size{std::max(initial_block_size, 2*sizeof(detail::upstream_block))}
+    , _next_block_size{_initial_block_size}
+    , _upstream{upstream}
+    {}
+
+    //! Use the given buffer before requesting memory from the upstream resource
+    explicit arena(std::span<std::byte> buffer,
+                   std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+    : arena{std::max(buffer.size(), std::size_t{4096}), upstream} {
+        _buffer = buffer;
+        _current = buffer.data();
+        _end = buffer.data() + buffer.size();
+    }
+
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+
+    ~arena() override {
+        release();
+    }
+
+    //! Return memory for the given number of bytes with the given alignment (a power of two)
+    [[nodiscard]] void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+        std::byte* result = detail::align_up(_current, alignment);
+        const auto padding = static_cast<std::size_t>(result - _current);
+        if (_current == nullptr || padding + bytes > static_cast<std::size_t>(_end - _current))
+            return _allocate_from_new_block(bytes, alignment);
+        _current = result + bytes;
+        return result;
+    }
+
+    //! No-op, memory is only freed by release()
+    void deallocate(void*, std::size_t, std::size_t = alignof(std::max_align_t)) noexcept {}
+
+    //! Free all memory requested from the upstream resource and start over with the initial buffer and block size
+    void release() noexcept {
+        detail::release_upstream_blocks(_last_block, _upstream);
+        _next_block_size = _initial_block_size;
+        _current = _buffer.data();
+        _end = _buffer.data() + _buffer.size();
+    }
+
+    std::pmr::memory_resource* upstream_resource() const noexcept {
+        return _upstream;
+    }
+
+ private:
+    void* _allocate_from_new_block(std::size_t bytes, std::size_t alignment) {
+        constexpr std::size_t header_size = sizeof(detail::upstream_block);
+        const std::size_t size = std::max(_next_block_size, header_size + bytes + alignment);
+        auto* block = ::new (_upstream->allocate(size, alignof(std::max_align_t))) detail::upstream_block{
+            _last_block, size
+        };
+        _last_block = block;
+        _next_block_size = 2*size;
+        _current = reinterpret_cast<std::byte*>(block) + header_size;
+        _end = reinterpret_cast<std::byte*>(block) + size;
+        return allocate(bytes, alignment);
+    }
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        return allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::span<std::byte> _buffer;
+    std::byte* _current = nullptr;
+    std::byte* _end = nullptr;
+    detail::upstream_block* _last_block = nullptr;
+    std::size_t _initial_block_size;
+    std::size_t _next_block_size;
+    std::pmr::memory_resource* _upstream;
+};
+
+//! Allocator for blocks of a fixed size and alignment, which are carved out of chunks requested from an upstream
+//! resource. Freed blocks are kept in a free list, such that allocation and deallocation are O(1). Not thread-safe.
+template<std::size_t block_size, std::size_t block_alignment = alignof(std::max_align_t)>
+    requires(block_size > 0 and std::has_single_bit(block_alignment))
+class pool : public std::pmr::memory_resource {
+ public:
+    static constexpr std::size_t alignment = std::max(block_alignment, alignof(detail::free_list::node));
+    static constexpr std::size_t stride = (std::max(block_size, sizeof(detail::free_list::node)) + alignment - 1)
+                                          /alignment*alignment;
+
+    explicit pool(std::size_t blocks_per_chunk = 64,
+                  std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+    : _blocks_per_chunk{std::max(blocks_per_chunk, std::size_t{1})}
+    , _upstream{upstream}
+    {}
+
+    pool(pool&& other) noexcept
+    : _free{std::exchange(other._free, {})}
+    , _last_chunk{std::exchange(other._last_chunk, nullptr)}
+    , _blocks_per_chunk{other._blocks_per_chunk}
+    , _upstream{other._upstream}
+    {}
+
+    pool(const pool&) = delete;
+    pool& operator=(const pool&) = delete;
+    pool& operator=(pool&&) = delete;
+
+    ~pool() override {
+        release();
+    }
+
+    using std::pmr::memory_resource::allocate;
+    using std::pmr::memory_resource::deallocate;
+
+    //! Return a block of memory of size block_size
+    [[nodiscard]] void* allocate() {
+        if (!_free.head)
+            _allocate_chunk();
+        return _free.pop();
+    }
+
+    //! Return the given block (obtained from allocate()) to the pool
+    void deallocate(void* block) noexcept {
+        _free.push(block);
+    }
+
+    //! Free all chunks, invalidating all blocks handed out so far
+    void release() noexcept {
+        detail::release_upstream_blocks(_last_chunk, _upstream, chunk_alignment);
+        _free = {};
+    }
+
+    std::pmr::memory_resource* upstream_resource() const noexcept {
+        return _upstream;
+    }
+
+ private:
+    static constexpr std::size_t header_size = (sizeof(detail::upstream_block) + alignment - 1)/alignment*alignment;
+    static constexpr std::size_t max_blocks_per_chunk = 4096;
+    static constexpr std::size_t chunk_alignment = std::max(alignment, alignof(std::max_align_t));
+
+    void _allocate_chunk() {
+        const std::size_t size = header_size + _blocks_per_chunk*stride;
+        auto* chunk = ::new (_upstream->allocate(size, chunk_alignment)) detail::upstream_block{
+            _last_chunk, size
+        };
+        _last_chunk = chunk;
+        std::byte* blocks = reinterpret_cast<std::byte*>(chunk) + header_size;
+        for (std::size_t i = _blocks_per_chunk; i > 0; --i)
+            _free.push(blocks + (i - 1)*stride);
+        _blocks_per_chunk = std::min(2*_blocks_per_chunk, std::max(_blocks_per_chunk, max_blocks_per_chunk));
+    }
+
+    void* do_allocate(std::size_t bytes, std::size_t requested_alignment) override {
+        if (bytes > block_size or requested_alignment > alignment)
+            throw std::bad_alloc{};
+        return allocate();
+    }
+
+    void do_deallocate(void* block, std::size_t, std::size_t) override {
+        deallocate(block);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    detail::free_list _free;
+    detail::upstream_block* _last_chunk = nullptr;
+    std::size_t _blocks_per_chunk;
+    std::pmr::memory_resource* _upstream;
+};
+
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename T>
+    struct pool_for : pool<sizeof(T), alignof(T)> {
+        using pool<sizeof(T), alignof(T)>::pool;
+    };
+
+    // number of blocks moved at once between the shared pools and the thread-local caches of typed_pools
+    inline constexpr std::size_t pool_cache_batch = 32;
+
+    // ids of typed_pools instances, which are never reused (unlike addresses)
+    inline std::atomic<std::uint64_t> next_typed_pools_id{1};
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+//! Pools for a closed set of types, with one pool per type (selected at compile time) and O(1) allocate<T>() and
+//! deallocate<T>(). Can be used concurrently: each thread allocates from and deallocates into a thread-local cache,
+//! which exchanges batches of blocks with the shared pools. Blocks cached by a thread that exits are only reclaimed
+//! when the typed_pools is destroyed. As memory_resource, requests are served by the smallest pool that fits (and
+//! by the upstream resource if none does).
+template<typename... Ts> requires(are_unique_v<Ts...> and sizeof...(Ts) > 0)
+class typed_pools : public std::pmr::memory_resource {
+ public:
+    explicit typed_pools(std::size_t blocks_per_chunk = 64,
+                         std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+    : _pools{detail::pool_for<Ts>{blocks_per_chunk, upstream}...}
+    , _upstream{upstream}
+    {}
+
+    typed_pools(const typed_pools&) = delete;
+    typed_pools& operator=(const typed_pools&) = delete;
+
+    //! Return the index of the pool that stores the given type
+    template<typename T>
+    static constexpr auto index_of() noexcept {
+        return indexed<Ts...>{}.template index_of<T>();
+    }
+
+    using std::pmr::memory_resource::allocate;
+    using std::pmr::memory_resource::deallocate;
+
+    //! Return uninitialized memory for an object of type T
+    template<typename T> requires(is_any_of_v<T, Ts...>)
+    [[nodiscard]] T* allocate() {
+        detail::free_list& cached = _local_cache().blocks[index_of<T>().value];
+        if (!cached.head) {
+            std::scoped_lock lock{_mutex};
+            for (std::size_t i = 0; i < detail::pool_cache_batch; ++i)
+                cached.push(_pool<T>().allocate());
+        }
+        return static_cast<T*>(cached.pop());
+    }
+
+    //! Return the memory of an object of type T (obtained from allocate<T>()) to its pool
+    template<typename T> requires(is_any_of_v<T, Ts...>)
+    void deallocate(T* object) {
+        detail::free_list& cached = _local_cache().blocks[index_of<T>().value];
+        cached.push(object);
+        if (cached.size > 2*detail::pool_cache_batch) {
+            std::scoped_lock lock{_mutex};
+            for (std::size_t i = 0; i < detail::pool_cache_batch; ++i)
+                _pool<T>().deallocate(cached.pop());
+        }
+    }
+
+    //! Allocate and construct an object of type T from the given arguments
+    template<typename T, typename... Args> requires(is_any_of_v<T, Ts...>)
+    [[nodiscard]] T* create(Args&&... args) {
+        T* memory = allocate<T>();
+        try {
+            return ::new (static_cast<void*>(memory)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate(memory);
+            throw;
+        }
+    }
+
+    //! Destroy and deallocate the given object (obtained from create<T>())
+    template<typename T> requires(is_any_of_v<T, Ts...>)
+    void destroy(T* object) {
+        object->~T();
+        deallocate(object);
+    }
+
+    std::pmr::memory_resource* upstream_resource() const noexcept {
+        return _upstream;
+    }
+
+ private:
+    static constexpr std::size_t size = sizeof...(Ts);
+    static constexpr std::array<std::size_t, size> _block_sizes{sizeof(Ts)...};
+    static constexpr std::array<std::size_t, size> _block_alignments{detail::pool_for<Ts>::alignment...};
+    static constexpr auto _by_block_size = detail::sorted_indices<detail::less>(_block_sizes);
+
+    struct cache {
+        std::thread::id thread;
+        std::array<detail::free_list, size> blocks{};
+    };
+
+    template<typename T>
+    detail::pool_for<T>& _pool() noexcept {
+        return _pools.get(index_of<T>());
+    }
+
+    cache& _local_cache() {
+        thread_local detail::instance_cache<cache*> caches;
+        return *caches.get(_id, [&] () { return &_register_thread(); });
+    }
+
+    cache& _register_thread() {
+        std::scoped_lock lock{_mutex};
+        const auto thread = std::this_thread::get_id();
+        for (const auto& c : _caches)
+            if (c->thread == thread)
+                return *c;
+        return *_caches.emplace_back(std::make_unique<cache>(cache{.thread = thread}));
+    }
+
+    // index of the smallest pool that can serve the given request (or size if there is none)
+    static std::size_t _pool_index(std::size_t bytes, std::size_t alignment) noexcept {
+        for (const std::size_t i : _by_block_size)
+            if (bytes <= _block_sizes[i] and alignment <= _block_alignments[i])
+                return i;
+        return size;
+    }
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        const std::size_t i = _pool_index(bytes, alignment);
+        if (i == size)
+            return _upstream->allocate(bytes, alignment);
+        return with_index<size>(i, [&] <std::size_t k> (const index_constant<k>&) -> void* {
+            return allocate<type_list_at_t<k, type_list<Ts...>>>();
+        });
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        const std::size_t i = _pool_index(bytes, alignment);
+        if (i == size)
+            return _upstream->deallocate(p, bytes, alignment);
+        with_index<size>(i, [&] <std::size_t k> (const index_constant<k>&) {
+            deallocate(static_cast<type_list_at_t<k, type_list<Ts...>>*>(p));
+        });
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    const std::uint64_t _id = detail::next_typed_pools_id.fetch_add(1, std::memory_order_relaxed);
+    std::mutex _mutex;
+    indexed_tuple<detail::pool_for<Ts>...> _pools;
+    std::vector<std::unique_ptr<cache>> _caches;
+    std::pmr::memory_resource* _upstream;
+};
+
+}  // namespace cpputils
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <bit>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <charconv>
+#include <algorithm>
+#include <string_view>
+
+#include <cpputils/type_traits.hpp>
+#include <cpputils/utility.hpp>
+
+namespace cpputils {
+
+//! Statistics of the durations recorded for one type. The histogram has logarithmic buckets: bucket i counts the
+//! durations d with bit_width(d) == i, i.e. bucket 0 counts zero durations and bucket i > 0 counts the durations in
+//! [2^(i-1), 2^i) nanoseconds (the last bucket also counts all longer durations). Trivially copyable, such that
+//! snapshots can be written with cpputils::serialize.
+struct type_statistics {
+    static constexpr std::size_t histogram_buckets = 48;
+
+    std::uint64_t count = 0;
+    std::uint64_t total_ns = 0;
+    std::uint64_t min_ns = 0;
+    std::uint64_t max_ns = 0;
+    std::array<std::uint64_t, histogram_buckets> histogram{};
+
+    //! Return the index of the histogram bucket that counts the given duration
+    static constexpr std::size_t bucket_of(std::uint64_t ns) noexcept {
+        return std::min<std::size_t>(std::bit_width(ns), histogram_buckets - 1);
+    }
+
+    double mean_ns() const noexcept {
+        return count == 0 ? 0.0 : static_cast<double>(total_ns)/static_cast<double>(count);
+    }
+
+    //! Return an upper bound for the given quantile (in [0, 1]) of the durations, with the resolution of the histogram
+    std::uint64_t quantile_ns(double q) const noexcept {
+        const auto rank = static_cast<std::uint64_t>(q*static_cast<double>(count));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < histogram_buckets; ++i) {
+            seen += histogram[i];
+            if (seen > rank)
+                return std::min(i == 0 ? 0 : (std::uint64_t{1} << i) - 1, max_ns);
+        }
+        return max_ns;
+    }
+
+    //! Add the statistics of the given durations to these
+    void merge(const type_statistics& other) noexcept {
+        if (other.count == 0)
+            return;
+        min_ns = count == 0 ? other.min_ns : std::min(min_ns, other.min_ns);
+        max_ns = std::max(max_ns, other.max_ns);
+        count += other.count;
+        total_ns += other.total_ns;
+        for (std::size_t i = 0; i < histogram_buckets; ++i)
+            histogram[i] += other.histogram[i];
+    }
+
+    friend bool operator==(const type_statistics&, const type_statistics&) = default;
+};
+
+#ifndef DOXYGEN
+namespace detail {
+
+    inline std::atomic<std::uint64_t> next_type_metrics_id{1};
+
+    // statistics of one type recorded by a single thread: the owning thread only loads and stores (no read-modify-
+    // write operations), other threads may read concurrently
+    struct alignas(cache_line_size) metrics_slot {
+        std::atomic<std::uint64_t> count{0};
+        std::atomic<std::uint64_t> total_ns{0};
+        std::atomic<std::uint64_t> min_ns{std::numeric_limits<std::uint64_t>::max()};
+        std::atomic<std::uint64_t> max_ns{0};
+        std::array<std::atomic<std::uint64_t>, type_statistics::histogram_buckets> histogram{};
+
+        static void add(std::atomic<std::uint64_t>& counter, std::uint64_t value) noexcept {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        void record(std::uint64_t ns) noexcept {
+            add(count, 1);
+            add(total_ns, ns);
+            add(histogram[type_statistics::bucket_of(ns)], 1);
+            if (ns < min_ns.load(std::memory_order_relaxed))
+                min_ns.store(ns, std::memory_order_relaxed);
+            if (ns > max_ns.load(std::memory_order_relaxed))
+                max_ns.store(ns, std::memory_order_relaxed);
+        }
+
+        type_statistics load() const noexcept {
+            type_statistics result;
+            result.count = count.load(std::memory_order_relaxed);
+            if (result.count == 0)
+                return result;
+            result.total_ns = total_ns.load(std::memory_order_relaxed);
+            result.min_ns = min_ns.load(std::memory_order_relaxed);
+            result.max_ns = max_ns.load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i < type_statistics::histogram_buckets; ++i)
+                result.histogram[i] = histogram[i].load(std::memory_order_relaxed);
+            return result;
+        }
+    };
+
+    template<typename O>
+    O write_json_number(O out, std::uint64_t value) {
+        char buffer[std::numeric_limits<std::uint64_t>::digits10 + 1];
+        return std::copy(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr, out);
+    }
+
+    template<typename O>
+    O write_json_text(O out, std::string_view text) {
+        return std::copy(text.begin(), text.end(), out);
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+//! Per-type counters and timers for a closed set of types, e.g. to instrument a processing loop per message type.
+//! Each thread records into its own shard (with one cache-line-aligned slot per type), such that recording costs a
+//! thread-local lookup and a few relaxed loads and stores, without contention or hashing. Reading merges the shards
+//! of all threads (which is consistent per slot only if no events are recorded concurrently).
+template<typename... Ts> requires(are_unique_v<Ts...> and sizeof...(Ts) > 0)
+class type_metrics {
+    static constexpr std::size_t size = sizeof...(Ts);
+
+ public:
+    using clock = std::chrono::steady_clock;
+    using snapshot_type = std::array<type_statistics, size>;
+
+    //! Timer that records the duration between its construction and its destruction
+    class scoped_timer {
+     public:
+        explicit scoped_timer(detail::metrics_slot& slot) noexcept
+        : _slot{&slot}
+        , _start{clock::now()}
+        {}
+
+        scoped_timer(const scoped_timer&) = delete;
+        scoped_timer& operator=(const scoped_timer&) = delete;
+
+        ~scoped_timer() {
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - _start);
+            _slot->record(static_cast<std::uint64_t>(std::max(elapsed.count(), std::int64_t{0})));
+        }
+
+     private:
+        detail::metrics_slot* _slot;
+        clock::time_point _start;
+    };
+
+    type_metrics() = default;
+    type_metrics(const type_metrics&) = delete;
+    type_metrics& operator=(const type_metrics&) = delete;
+
+    //! Return the index of the given type in snapshots
+    template<typename T>
+    static constexpr auto index_of() noexcept {
+        return indexed<Ts...>{}.template index_of<T>();
+    }
+
+    //! Record an event of the given type that took the given duration (negative durations are recorded as zero)
+    template<typename T> requires(is_any_of_v<T, Ts...>)
+    void record(std::chrono::nanoseconds duration = std::chrono::nanoseconds{0}) {
+        const auto ns = std::max(duration.count(), std::chrono::nanoseconds::rep{0});
+        _local_shard()[index_of<T>().value].record(static_cast<std::uint64_t>(ns));
+    }
+
+    //! Return a timer that records an event of the given type when it goes out of scope
+    template<typename T> requires(is_any_of_v<T, Ts...>)
+    [[nodiscard]] scoped_timer measure() {
+        return scoped_timer{_local_shard()[index_of<T>().value]};
+    }
+
+    //! Return the statistics of the given type, merged over all threads
+    template<typename T> requires(is_any_of_v<T, Ts...>)
+    type_statistics statistics() const {
+        type_statistics result;
+        std::scoped_lock lock{_mutex};
+        for (const auto& shard : _shards)
+            result.merge(shard->slots[index_of<T>().value].load());
+        return result;
+    }
+
+    //! Return the statistics of all types (in the order of Ts), merged over all threads. The snapshot can be written
+    //! in binary form via cpputils::serialize, or as JSON via write_json.
+    snapshot_type snapshot() const {
+        snapshot_type result{};
+        std::scoped_lock lock{_mutex};
+        for (const auto& shard : _shards)
+            for (std::size_t i = 0; i < size; ++i)
+                result[i].merge(shard->slots[i].load());
+        return result;
+    }
+
+ private:
+    struct shard {
+        std::thread::id thread;
+        std::array<detail::metrics_slot, size> slots{};
+    };
+
+    std::array<detail::metrics_slot, size>& _local_shard() {
+        thread_local detail::instance_cache<shard*> shards;
+        return shards.get(_id, [&] () { return &_register_thread(); })->slots;
+    }
+
+    shard& _register_thread() {
+        std::scoped_lock lock{_mutex};
+        const auto thread = std::this_thread::get_id();
+        for (const auto& s : _shards)
+            if (s->thread == thread)
+                return *s;
+        auto& result = *_shards.emplace_back(std::make_unique<shard>());
+        result.thread = thread;
+        return result;
+    }
+
+    const std::uint64_t _id = detail::next_type_metrics_id.fetch_add(1, std::memory_order_relaxed);
+    mutable std::mutex _mutex;
+    std::vector<std::unique_ptr<shard>> _shards;
+};
+
+//! Write the given statistics as a JSON array with one object per type, for example
+//! `[{"index":0,"count":2,"total_ns":30,"min_ns":10,"max_ns":20,"histogram":[0,0,0,0,1,1]}]`. Trailing empty
+//! histogram buckets are omitted. Returns the iterator past the last written character.
+template<std::size_t n, typename O> requires(requires(O o, char c) { *o++ = c; })
+O write_json(const std::array<type_statistics, n>& snapshot, O out) {
+    *out++ = '[';
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto& statistics = snapshot[i];
+        out = detail::write_json_text(out, i == 0 ? "{\"index\":" : ",{\"index\":");
+        out = detail::write_json_number(out, i);
+        out = detail::write_json_text(out, ",\"count\":");
+        out = detail::write_json_number(out, statistics.count);
+        out = detail::write_json_text(out, ",\"total_ns\":");
+        out = detail::write_json_number(out, statistics.total_ns);
+        out = detail::write_json_text(out, ",\"min_ns\":");
+        out = detail::write_json_number(out, statistics.min_ns);
+        out = detail::write_json_text(out, ",\"max_ns\":");
+        out = detail::write_json_number(out, statistics.max_ns);
+        out = detail::write_json_text(out, ",\"histogram\":[");
+        std::size_t buckets = type_statistics::histogram_buckets;
+        while (buckets > 0 and statistics.histogram[buckets - 1] == 0)
+            --buckets;
+        for (std::size_t b = 0; b < buckets; ++b) {
+            if (b > 0)
+                *out++ = ',';
+            out = detail::write_json_number(out, statistics.histogram[b]);
+        }
+        out = detail::write_json_text(out, "]}");
+    }
+    *out++ = ']';
+    return out;
+}
+
+}  // namespace cpputils
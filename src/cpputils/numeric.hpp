@@ -0,0 +1,122 @@
+#pragma once
+
+#include <span>
+#include <array>
+#include <ranges>
+#include <cstddef>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+
+#include <cpputils/utility.hpp>
+
+namespace cpputils {
+
+//! Concept for contiguous ranges of arithmetic values, such as std::array, std::vector or values<...>::as_array()
+template<typename R>
+concept arithmetic_range = std::ranges::contiguous_range<R>
+    and std::ranges::sized_range<R>
+    and std::is_arithmetic_v<std::ranges::range_value_t<R>>;
+
+
+#ifndef DOXYGEN
+namespace detail {
+
+    // Number of independent partial results used in reductions. Because floating-point addition is not associative,
+    // the compiler may only vectorize a reduction if its partial results are already independent in the source.
+    inline constexpr std::size_t lanes = 8;
+
+    template<typename T, std::size_t extent, typename Init, typename Accumulate, typename Combine>
+    constexpr T reduce(std::span<const T, extent> values, const Init& init, const Accumulate& accumulate, const Combine& combine) {
+        const std::size_t size = values.size();
+        const std::size_t vectorized_size = size - size%lanes;
+        std::array<T, lanes> partial;
+        partial.fill(init);
+        for (std::size_t i = 0; i < vectorized_size; i += lanes)
+            for (std::size_t lane = 0; lane < lanes; ++lane)
+                partial[lane] = accumulate(partial[lane], values[i + lane]);
+        for (std::size_t i = vectorized_size; i < size; ++i)
+            partial[0] = accumulate(partial[0], values[i]);
+        for (std::size_t lane = 1; lane < lanes; ++lane)
+            partial[0] = combine(partial[0], partial[lane]);
+        return partial[0];
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+//! Return the sum of all values in the given range. The summation order differs from a sequential loop.
+template<arithmetic_range R>
+constexpr auto sum(const R& range) noexcept {
+    using T = std::ranges::range_value_t<R>;
+    const auto plus = [] (const T& a, const T& b) { return a + b; };
+    return detail::reduce(std::span{std::as_const(range)}, T{0}, plus, plus);
+}
+
+//! Return the smallest value in the given (non-empty) range
+template<arithmetic_range R>
+constexpr auto min(const R& range) noexcept {
+    using T = std::ranges::range_value_t<R>;
+    const auto smaller = [] (const T& a, const T& b) { return b < a ? b : a; };
+    const std::span values{std::as_const(range)};
+    return detail::reduce(values, values[0], smaller, smaller);
+}
+
+//! Return the largest value in the given (non-empty) range
+template<arithmetic_range R>
+constexpr auto max(const R& range) noexcept {
+    using T = std::ranges::range_value_t<R>;
+    const auto larger = [] (const T& a, const T& b) { return a < b ? b : a; };
+    const std::span values{std::as_const(range)};
+    return detail::reduce(values, values[0], larger, larger);
+}
+
+//! Return the dot product of two ranges of equal size. The summation order differs from a sequential loop.
+template<arithmetic_range A, arithmetic_range B>
+constexpr auto dot(const A& a, const B& b) noexcept {
+    using T = decltype(std::declval<std::ranges::range_value_t<A>>()*std::declval<std::ranges::range_value_t<B>>());
+    const std::span lhs{std::as_const(a)};
+    const std::span rhs{std::as_const(b)};
+    const std::size_t size = lhs.size();
+    const std::size_t vectorized_size = size - size%detail::lanes;
+    std::array<T, detail::lanes> partial{};
+    for (std::size_t i = 0; i < vectorized_size; i += detail::lanes)
+        for (std::size_t lane = 0; lane < detail::lanes; ++lane)
+            partial[lane] += lhs[i + lane]*rhs[i + lane];
+    for (std::size_t i = vectorized_size; i < size; ++i)
+        partial[0] += lhs[i]*rhs[i];
+    return sum(partial);
+}
+
+//! Write the inclusive prefix sums of the given range into the given output range (of at least the same size)
+template<arithmetic_range R, arithmetic_range O>
+constexpr void inclusive_scan(const R& range, O&& output) noexcept {
+    const std::span values{std::as_const(range)};
+    const std::span result{output};
+    std::ranges::range_value_t<O> running{0};
+    for (std::size_t i = 0; i < values.size(); ++i)
+        result[i] = running += values[i];
+}
+
+//! Apply the stencil given by the (signed, integral) offsets and the weights to the input, that is, set
+//! `output[i] = sum_k weights[k]*input[i + offsets[k]]` for all i for which all `i + offsets[k]` are valid indices.
+//! The remaining entries of the output (of the same size as the input) are left untouched. The stencil is expanded
+//! into straight-line code, such that the compiler can vectorize the loop over i.
+template<auto... offsets, auto... weights, arithmetic_range R, arithmetic_range O>
+    requires(sizeof...(offsets) == sizeof...(weights) and sizeof...(offsets) > 0 and
+             (std::is_integral_v<decltype(offsets)> and ...))
+constexpr void stencil_apply(const values<offsets...>&, const values<weights...>&, const R& input, O&& output) noexcept {
+    const std::span in{std::as_const(input)};
+    const std::span out{output};
+    using T = std::ranges::range_value_t<O>;
+
+    constexpr std::ptrdiff_t min_offset = std::min({std::ptrdiff_t{0}, static_cast<std::ptrdiff_t>(offsets)...});
+    constexpr std::ptrdiff_t max_offset = std::max({std::ptrdiff_t{0}, static_cast<std::ptrdiff_t>(offsets)...});
+    const auto size = static_cast<std::ptrdiff_t>(in.size());
+    for (std::ptrdiff_t i = -min_offset; i < size - max_offset; ++i) {
+        const auto* center = in.data() + i;
+        out[static_cast<std::size_t>(i)] = (... + static_cast<T>(weights*center[offsets]));
+    }
+}
+
+}  // namespace cpputils
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <ostream>
+#include <iterator>
+
+#include <cpputils/utility.hpp>
+
+namespace cpputils {
+
+//! Write the given list of values to the given output stream (separated by ", ")
+template<auto... v> requires(detail::printable_value<decltype(v)> and ...)
+std::ostream& operator<<(std::ostream& s, const values<v...>& list) {
+    list.write_to(std::ostreambuf_iterator<char>{s});
+    return s;
+}
+
+}  // namespace cpputils
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <mutex>
+#include <deque>
+#include <algorithm>
+#include <latch>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <exception>
+#include <concepts>
+#include <functional>
+#include <type_traits>
+#include <condition_variable>
+
+#include <cpputils/utility.hpp>
+
+namespace cpputils {
+
+//! Concept for executors that run the given tasks asynchronously
+template<typename E>
+concept executor = requires(E& e, std::function<void()> task) {
+    { e.execute(std::move(task)) };
+};
+
+//! Concept for executors that expose the number of tasks they run concurrently via size()
+template<typename E>
+concept sized_executor = executor<E> and requires(const E& e) {
+    { e.size() } -> std::convertible_to<std::size_t>;
+};
+
+//! A fixed-size pool of worker threads that execute the submitted tasks in FIFO order
+class thread_pool {
+ public:
+    explicit thread_pool(std::size_t thread_count = std::max(1u, std::thread::hardware_concurrency())) {
+        _threads.reserve(thread_count);
+        for (std::size_t i = 0; i < thread_count; ++i)
+            _threads.emplace_back([this] () { _work(); });
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    //! Finishes all pending tasks and joins the threads
+    ~thread_pool() {
+        {
+            std::scoped_lock lock{_mutex};
+            _stop = true;
+        }
+        _condition.notify_all();
+    }
+
+    //! Submit a task to be executed on one of the threads
+    void execute(std::function<void()> task) {
+        {
+            std::scoped_lock lock{_mutex};
+            _tasks.push_back(std::move(task));
+        }
+        _condition.notify_one();
+    }
+
+    std::size_t size() const noexcept {
+        return _threads.size();
+    }
+
+ private:
+    void _work() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock lock{_mutex};
+                _condition.wait(lock, [this] () { return _stop || !_tasks.empty(); });
+                if (_tasks.empty())
+                    return;
+                task = std::move(_tasks.front());
+                _tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::deque<std::function<void()>> _tasks;
+    bool _stop = false;
+    std::vector<std::jthread> _threads;  // declared last s.t. the threads are joined before the members are destroyed
+};
+
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename Tuple, typename Action, typename Spawn>
+    void parallel_for_each(Tuple& tuple, Action& action, Spawn&& spawn) {
+        constexpr std::size_t size = std::remove_cvref_t<Tuple>::size;
+        if constexpr (size > 0) {
+            std::latch done{static_cast<std::ptrdiff_t>(size)};
+            std::exception_ptr exception;
+            std::mutex exception_mutex;
+            const auto run = [&] (auto index) noexcept {
+                try {
+                    action(tuple.get(index));
+                } catch (...) {
+                    std::scoped_lock lock{exception_mutex};
+                    if (!exception)
+                        exception = std::current_exception();
+                }
+                done.count_down();
+            };
+
+            // the last element is processed on the calling thread, as well as those that could not be spawned
+            const auto spawn_or_run = [&] (auto index) noexcept {
+                try {
+                    spawn([&run, index] () { run(index); });
+                } catch (...) {
+                    run(index);
+                }
+            };
+            [&] <std::size_t... i> (const std::index_sequence<i...>&) {
+                (..., spawn_or_run(index_constant<i>{}));
+            }(std::make_index_sequence<size - 1>{});
+            run(index_constant<size - 1>{});
+            done.wait();
+
+            if (exception)
+                std::rethrow_exception(exception);
+        }
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+//! Invoke the given action concurrently on all elements of the given indexed_tuple, using the given executor.
+//! Returns after all invocations have finished, and rethrows the first exception thrown by any of them.
+//! Note: must not be called from within a task of an executor that may not have idle threads left.
+template<typename Tuple, typename Action, executor Executor> requires(is_indexed_tuple_v<std::remove_cvref_t<Tuple>>)
+void parallel_for_each(Tuple&& tuple, Action&& action, Executor& executor) {
+    detail::parallel_for_each(tuple, action, [&] (auto&& task) {
+        executor.execute(std::function<void()>{std::move(task)});
+    });
+}
+
+//! Invoke the given action concurrently on all elements of the given indexed_tuple, using one thread per element.
+//! Returns after all invocations have finished, and rethrows the first exception thrown by any of them.
+template<typename Tuple, typename Action> requires(is_indexed_tuple_v<std::remove_cvref_t<Tuple>>)
+void parallel_for_each(Tuple&& tuple, Action&& action) {
+    std::vector<std::jthread> threads;
+    threads.reserve(std::remove_cvref_t<Tuple>::size);
+    detail::parallel_for_each(tuple, action, [&] (auto&& task) {
+        threads.emplace_back(std::move(task));
+    });
+}
+
+}  // namespace cpputils
@@ -0,0 +1,343 @@
+#pragma once
+
+#include <bit>
+#include <array>
+#include <span>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <concepts>
+#include <stdexcept>
+#include <type_traits>
+
+#include <cpputils/utility.hpp>
+#include <cpputils/type_name.hpp>
+
+namespace cpputils {
+
+//! Customization point for the binary (de)serialization of T. Specializations provide:
+//! - `static constexpr std::uint64_t schema`: a hash of the binary layout (see `detail::schema_hash_of`)
+//! - `static std::size_t size(const T&)`: the number of bytes needed to serialize the given value
+//! - `static std::byte* write(const T&, std::byte* out)`: write the value and return the end of the written bytes
+//! - `static void read(T&, std::span<const std::byte>& in)`: read the value and remove the read bytes from `in`
+template<typename T>
+struct serializer;
+
+//! Concept for types that can be serialized via the serializer customization point
+template<typename T>
+concept serializable = requires(const T& value, T& target, std::byte* out, std::span<const std::byte>& in) {
+    { serializer<T>::schema } -> std::convertible_to<std::uint64_t>;
+    { serializer<T>::size(value) } -> std::same_as<std::size_t>;
+    { serializer<T>::write(value, out) } -> std::same_as<std::byte*>;
+    { serializer<T>::read(target, in) };
+};
+
+//! Exception thrown when reading data that was written with a different schema
+struct schema_mismatch : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+
+#ifndef DOXYGEN
+namespace detail {
+
+    // FNV-1a hash over the bytes of the given integers (each taken as 64-bit little-endian number)
+    template<std::integral... I>
+    constexpr std::uint64_t fnv1a(std::uint64_t hash, I... values) noexcept {
+        (..., [&] (std::uint64_t value) {
+            for (int byte = 0; byte < 8; ++byte) {
+                hash ^= (value >> 8*byte) & 0xff;
+                hash *= fnv_prime;
+            }
+        }(static_cast<std::uint64_t>(values)));
+        return hash;
+    }
+
+    enum class schema_kind : std::uint8_t {
+        boolean = 1,
+        character,
+        signed_integer,
+        unsigned_integer,
+        floating_point,
+        enumeration,
+        trivial_class,
+        string,
+        vector,
+        tuple,
+        values
+    };
+
+    template<typename T>
+    constexpr schema_kind kind_of() noexcept {
+        if constexpr (std::is_same_v<T, bool>)
+            return schema_kind::boolean;
+        else if constexpr (is_any_of_v<T, char, wchar_t, char8_t, char16_t, char32_t>)
+            return schema_kind::character;
+        else if constexpr (std::is_integral_v<T>)
+            return std::is_signed_v<T> ? schema_kind::signed_integer : schema_kind::unsigned_integer;
+        else if constexpr (std::is_floating_point_v<T>)
+            return schema_kind::floating_point;
+        else if constexpr (std::is_enum_v<T>)
+            return schema_kind::enumeration;
+        else
+            return schema_kind::trivial_class;
+    }
+
+    //! Hash of the layout of a type, given by its kind, size and alignment, and the given further properties
+    template<std::integral... I>
+    constexpr std::uint64_t schema_hash_of(schema_kind kind, std::size_t size, std::size_t alignment, I... properties) noexcept {
+        const auto endianness = std::endian::native == std::endian::little ? 1 : 2;
+        return fnv1a(fnv_offset_basis, endianness, static_cast<std::uint8_t>(kind), size, alignment, properties...);
+    }
+
+    // bits of a value stored in a values<...> list
+    template<auto v>
+    constexpr std::uint64_t value_bits() noexcept {
+        using T = decltype(v);
+        if constexpr (std::is_enum_v<T>)
+            return static_cast<std::uint64_t>(static_cast<std::underlying_type_t<T>>(v));
+        else if constexpr (std::is_floating_point_v<T> and sizeof(T) == sizeof(std::uint32_t))
+            return std::bit_cast<std::uint32_t>(v);
+        else if constexpr (std::is_floating_point_v<T> and sizeof(T) == sizeof(std::uint64_t))
+            return std::bit_cast<std::uint64_t>(v);
+        else
+            return static_cast<std::uint64_t>(v);
+    }
+
+    inline std::span<const std::byte> take(std::span<const std::byte>& in, std::size_t size) {
+        if (in.size() < size)
+            throw std::length_error("Input buffer is too small");
+        const auto bytes = in.first(size);
+        in = in.subspan(size);
+        return bytes;
+    }
+
+    template<typename T>
+    inline constexpr bool is_memcpy_serializable = std::is_trivially_copyable_v<T>
+        and !std::is_pointer_v<T>
+        and !std::is_member_pointer_v<T>
+        and !is_indexed_tuple_v<T>;
+
+    // element types and storage order of the elements of an indexed_tuple or packed_indexed_tuple
+    template<typename Tuple>
+    struct indexed_tuple_layout;
+    template<typename... Ts>
+    struct indexed_tuple_layout<cpputils::indexed_tuple<Ts...>> {
+        using types = type_list<Ts...>;
+        // references are never copied with memcpy (which would copy and overwrite the binding), but element-wise
+        static constexpr bool is_memcpy_serializable = (detail::is_memcpy_serializable<Ts> and ...);
+        static constexpr bool has_serializable_elements = (serializable<std::remove_cvref_t<Ts>> and ...);
+        static constexpr std::array<std::size_t, sizeof...(Ts)> storage_order = [] () {
+            std::array<std::size_t, sizeof...(Ts)> order{};
+            for (std::size_t i = 0; i < order.size(); ++i)
+                order[i] = i;
+            return order;
+        } ();
+    };
+    template<typename... Ts>
+    struct indexed_tuple_layout<packed_indexed_tuple<Ts...>> : indexed_tuple_layout<cpputils::indexed_tuple<Ts...>> {
+        static constexpr std::array<std::size_t, sizeof...(Ts)> storage_order = alignment_sorted_order<Ts...>;
+    };
+
+    // layout of a sequence of elements stored as size followed by the elements
+    template<typename Container, typename T>
+    struct sequence_serializer {
+        static std::size_t size(const Container& values) {
+            if constexpr (is_memcpy_serializable<T>)
+                return sizeof(std::uint64_t) + values.size()*sizeof(T);
+            else {
+                std::size_t result = sizeof(std::uint64_t);
+                for (const auto& value : values)
+                    result += serializer<T>::size(value);
+                return result;
+            }
+        }
+
+        static std::byte* write(const Container& values, std::byte* out) {
+            const std::uint64_t count = values.size();
+            std::memcpy(out, &count, sizeof(count));
+            out += sizeof(count);
+            if constexpr (is_memcpy_serializable<T>) {
+                if (count > 0)
+                    std::memcpy(out, values.data(), count*sizeof(T));
+                return out + count*sizeof(T);
+            } else {
+                for (const auto& value : values)
+                    out = serializer<T>::write(value, out);
+                return out;
+            }
+        }
+
+        static void read(Container& values, std::span<const std::byte>& in) {
+            std::uint64_t count;
+            std::memcpy(&count, take(in, sizeof(count)).data(), sizeof(count));
+            if constexpr (is_memcpy_serializable<T>) {
+                if (count > in.size()/sizeof(T))
+                    throw std::length_error("Input buffer is too small");
+                values.resize(count);
+                if (count > 0)
+                    std::memcpy(values.data(), take(in, count*sizeof(T)).data(), count*sizeof(T));
+            } else {
+                values.clear();
+                for (std::uint64_t i = 0; i < count; ++i)
+                    serializer<T>::read(values.emplace_back(), in);
+            }
+        }
+    };
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+//! Trivially copyable types (except pointers) are copied with a single memcpy. The schema of class types contains
+//! their name (see type_id), since their members cannot be inspected: renaming a class changes its schema, changing
+//! its members without renaming it does not. Classes with pointer members must not be serialized with this
+//! specialization (which cannot detect them), but need a specialization of their own.
+template<typename T> requires(detail::is_memcpy_serializable<T>)
+struct serializer<T> {
+    static constexpr std::uint64_t schema = [] () {
+        if constexpr (std::is_enum_v<T>)
+            return detail::schema_hash_of(detail::kind_of<T>(), sizeof(T), alignof(T),
+                                          serializer<std::underlying_type_t<T>>::schema);
+        else if constexpr (std::is_class_v<T> or std::is_union_v<T>)
+            return detail::schema_hash_of(detail::kind_of<T>(), sizeof(T), alignof(T), type_id<std::remove_cv_t<T>>());
+        else
+            return detail::schema_hash_of(detail::kind_of<T>(), sizeof(T), alignof(T));
+    }();
+
+    static constexpr std::size_t size(const T&) noexcept { return sizeof(T); }
+
+    static std::byte* write(const T& value, std::byte* out) noexcept {
+        std::memcpy(out, &value, sizeof(T));
+        return out + sizeof(T);
+    }
+
+    static void read(T& value, std::span<const std::byte>& in) {
+        std::memcpy(&value, detail::take(in, sizeof(T)).data(), sizeof(T));
+    }
+};
+
+//! Strings are stored as their length followed by their characters
+template<typename C, typename Traits, typename Allocator> requires(serializable<C>)
+struct serializer<std::basic_string<C, Traits, Allocator>>
+: detail::sequence_serializer<std::basic_string<C, Traits, Allocator>, C> {
+    static constexpr std::uint64_t schema = detail::schema_hash_of(
+        detail::schema_kind::string, 0, 0, serializer<C>::schema
+    );
+};
+
+//! Vectors are stored as their size followed by their elements
+template<typename T, typename Allocator> requires(serializable<T> and std::is_default_constructible_v<T>)
+struct serializer<std::vector<T, Allocator>> : detail::sequence_serializer<std::vector<T, Allocator>, T> {
+    static constexpr std::uint64_t schema = detail::schema_hash_of(
+        detail::schema_kind::vector, 0, 0, serializer<T>::schema
+    );
+};
+
+//! Indexed tuples are copied with a single memcpy if they are trivially copyable and all of their elements can be
+//! copied with memcpy (no references or pointers), and element-wise otherwise. Reference elements are written and
+//! read as the referenced values. The schema contains the indices and schemas of all elements, and for memcpy-able
+//! tuples their size, alignment and storage order (which differs between indexed_tuple and packed_indexed_tuple).
+template<typename Tuple> requires(is_indexed_tuple_v<Tuple> and detail::indexed_tuple_layout<Tuple>::has_serializable_elements)
+struct serializer<Tuple> {
+ private:
+    using layout = detail::indexed_tuple_layout<Tuple>;
+
+    template<std::size_t i>
+    using element_t = std::remove_cvref_t<type_list_at_t<i, typename layout::types>>;
+
+    static constexpr bool is_trivial = std::is_trivially_copyable_v<Tuple> and layout::is_memcpy_serializable;
+
+    template<typename Action>
+    static constexpr decltype(auto) _apply(Action&& action) {
+        return [&] <std::size_t... i> (const std::index_sequence<i...>&) -> decltype(auto) {
+            return action.template operator()<i...>();
+        }(std::make_index_sequence<Tuple::size>{});
+    }
+
+ public:
+    static constexpr std::uint64_t schema = _apply([] <std::size_t... i> () {
+        return detail::schema_hash_of(
+            detail::schema_kind::tuple, is_trivial ? sizeof(Tuple) : 0, is_trivial ? alignof(Tuple) : 0,
+            Tuple::size, i..., (is_trivial ? layout::storage_order[i] : i)..., serializer<element_t<i>>::schema...
+        );
+    });
+
+    static std::size_t size(const Tuple& tuple) requires(serializable<element_t<0>>) {
+        if constexpr (is_trivial)
+            return sizeof(Tuple);
+        else
+            return _apply([&] <std::size_t... i> () {
+                return (std::size_t{0} + ... + serializer<element_t<i>>::size(tuple.get(ic<i>)));
+            });
+    }
+
+    static std::byte* write(const Tuple& tuple, std::byte* out) {
+        if constexpr (is_trivial) {
+            std::memcpy(static_cast<void*>(out), static_cast<const void*>(&tuple), sizeof(Tuple));
+            return out + sizeof(Tuple);
+        } else {
+            for_each(tuple, [&] <typename T> (const T& element) { out = serializer<T>::write(element, out); });
+            return out;
+        }
+    }
+
+    static void read(Tuple& tuple, std::span<const std::byte>& in) {
+        if constexpr (is_trivial)
+            std::memcpy(static_cast<void*>(&tuple), detail::take(in, sizeof(Tuple)).data(), sizeof(Tuple));
+        else
+            for_each(tuple, [&] <typename T> (T& element) { serializer<T>::read(element, in); });
+    }
+};
+
+//! Value lists have no runtime state, their schema encodes the values (such that readers can verify them)
+template<auto... v>
+struct serializer<values<v...>> {
+    static constexpr std::uint64_t schema = detail::schema_hash_of(
+        detail::schema_kind::values, sizeof...(v), 0, serializer<decltype(v)>::schema..., detail::value_bits<v>()...
+    );
+
+    static constexpr std::size_t size(const values<v...>&) noexcept { return 0; }
+    static std::byte* write(const values<v...>&, std::byte* out) noexcept { return out; }
+    static void read(values<v...>&, std::span<const std::byte>&) noexcept {}
+};
+
+//! Compile-time hash of the binary layout written by serialize for values of type T
+template<serializable T>
+inline constexpr std::uint64_t schema_hash = serializer<T>::schema;
+
+//! Return the number of bytes needed to serialize the given value (including its schema hash)
+template<serializable T>
+std::size_t serialized_size(const T& value) {
+    return sizeof(std::uint64_t) + serializer<T>::size(value);
+}
+
+//! Write the schema hash and the given value into the given buffer and return the number of bytes written.
+//! Throws std::length_error if the buffer is too small.
+template<serializable T>
+std::size_t serialize(const T& value, std::span<std::byte> buffer) {
+    const std::size_t size = serialized_size(value);
+    if (buffer.size() < size)
+        throw std::length_error("Output buffer is too small");
+    constexpr std::uint64_t schema = schema_hash<T>;
+    std::memcpy(buffer.data(), &schema, sizeof(schema));
+    serializer<T>::write(value, buffer.data() + sizeof(schema));
+    return size;
+}
+
+//! Read the given value from the given buffer and return the number of bytes read. Throws schema_mismatch if the
+//! data was written with a different schema, and std::length_error if the buffer ends prematurely.
+template<serializable T>
+std::size_t deserialize(T& value, std::span<const std::byte> buffer) {
+    auto in = buffer;
+    std::uint64_t schema;
+    std::memcpy(&schema, detail::take(in, sizeof(schema)).data(), sizeof(schema));
+    if (schema != schema_hash<T>)
+        throw schema_mismatch("Data was written with a different schema");
+    serializer<T>::read(value, in);
+    return buffer.size() - in.size();
+}
+
+}  // namespace cpputils
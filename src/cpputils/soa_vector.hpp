@@ -0,0 +1,254 @@
+#pragma once
+
+#include <new>
+#include <span>
+#include <tuple>
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include <concepts>
+#include <algorithm>
+#include <type_traits>
+
+#include <cpputils/type_traits.hpp>
+#include <cpputils/utility.hpp>
+
+namespace cpputils {
+
+//! Structure-of-arrays container that stores one contiguous, aligned array per type
+template<typename... Ts>
+    requires(are_unique_v<Ts...> and sizeof...(Ts) > 0 and
+             (std::is_nothrow_move_constructible_v<Ts> and ...) and
+             (std::is_nothrow_destructible_v<Ts> and ...))
+class soa_vector {
+    template<bool is_const>
+    class row_proxy {
+        using vector = std::conditional_t<is_const, const soa_vector, soa_vector>;
+
+     public:
+        constexpr row_proxy(vector& v, std::size_t i) noexcept : _vector{&v}, _i{i} {}
+
+        //! Return the field of the given type in this row
+        template<typename T>
+        constexpr auto& get() const noexcept {
+            return _vector->template col<T>()[_i];
+        }
+
+        //! Return the field at the given index in this row
+        template<std::size_t i>
+        constexpr auto& get(const index_constant<i>& idx) const noexcept {
+            return _vector->col(idx)[_i];
+        }
+
+     private:
+        vector* _vector;
+        std::size_t _i;
+    };
+
+ public:
+    using reference = row_proxy<false>;
+    using const_reference = row_proxy<true>;
+
+    //! Alignment (in bytes) of all columns
+    static constexpr std::size_t alignment = std::max({std::size_t{64}, alignof(Ts)...});
+
+    soa_vector() noexcept : _columns{static_cast<Ts*>(nullptr)...} {}
+
+    //! Construct a vector with n value-initialized rows
+    explicit soa_vector(std::size_t n) : soa_vector() {
+        resize(n);
+    }
+
+    soa_vector(const soa_vector& other) : soa_vector() {
+        reserve(other._size);
+        _construct_rows(0, other._size, [&] <typename T> (T* data, std::size_t count) {
+            std::uninitialized_copy_n(other.template _column<T>(), count, data);
+        });
+    }
+
+    soa_vector(soa_vector&& other) noexcept : soa_vector() {
+        swap(other);
+    }
+
+    soa_vector& operator=(soa_vector other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~soa_vector() {
+        clear();
+        _deallocate();
+    }
+
+    void swap(soa_vector& other) noexcept {
+        std::swap(_columns, other._columns);
+        std::swap(_size, other._size);
+        std::swap(_capacity, other._capacity);
+    }
+
+    //! Return the index of the column that stores the given type
+    template<typename T>
+    static constexpr auto index_of() noexcept {
+        return indexed<Ts...>{}.template index_of<T>();
+    }
+
+    std::size_t size() const noexcept { return _size; }
+    std::size_t capacity() const noexcept { return _capacity; }
+    bool empty() const noexcept { return _size == 0; }
+
+    //! Return a span over all values of the given type
+    template<typename T> requires(is_any_of_v<T, Ts...>)
+    std::span<T> col() noexcept {
+        return {_column<T>(), _size};
+    }
+
+    //! Return a span over all values of the given type
+    template<typename T> requires(is_any_of_v<T, Ts...>)
+    std::span<const T> col() const noexcept {
+        return {_column<T>(), _size};
+    }
+
+    //! Return a span over all values in the column with the given index
+    template<std::size_t i> requires(i < sizeof...(Ts))
+    auto col(const index_constant<i>&) noexcept {
+        return col<type_list_at_t<i, type_list<Ts...>>>();
+    }
+
+    //! Return a span over all values in the column with the given index
+    template<std::size_t i> requires(i < sizeof...(Ts))
+    auto col(const index_constant<i>&) const noexcept {
+        return col<type_list_at_t<i, type_list<Ts...>>>();
+    }
+
+    //! Return a proxy to the i-th row
+    reference operator[](std::size_t i) noexcept { return {*this, i}; }
+    const_reference operator[](std::size_t i) const noexcept { return {*this, i}; }
+
+    void reserve(std::size_t n) {
+        if (n > _capacity)
+            _reallocate(n);
+    }
+
+    //! Resize to n rows, value-initializing new rows
+    void resize(std::size_t n) {
+        if (n < _size)
+            _destroy_from(n);
+        else if (n > _size) {
+            reserve(n);
+            _construct_rows(_size, n - _size, [&] <typename T> (T* data, std::size_t count) {
+                std::uninitialized_value_construct_n(data, count);
+            });
+        }
+    }
+
+    //! Append a row constructed from the given arguments (one per column)
+    template<typename... Args>
+        requires(sizeof...(Args) == sizeof...(Ts) and (std::constructible_from<Ts, Args&&> and ...))
+    void emplace_back(Args&&... args) {
+        if (_size < _capacity)
+            _emplace_at(_size, std::forward<Args>(args)...);
+        else {
+            // construct the new row first, as the arguments may refer to elements of this vector
+            soa_vector grown;
+            grown._allocate(std::max(std::size_t{8}, 2*_capacity));
+            grown._emplace_at(_size, std::forward<Args>(args)...);
+            _move_into(grown);
+            swap(grown);
+        }
+    }
+
+    void push_back(const Ts&... values) { emplace_back(values...); }
+    void pop_back() noexcept { _destroy_from(_size - 1); }
+    void clear() noexcept { _destroy_from(0); }
+
+ private:
+    template<typename T>
+    T* _column() const noexcept {
+        return std::assume_aligned<alignment>(_columns.get(_columns.template index_of<T*>()));
+    }
+
+    template<typename Action>
+    void _for_each_column(Action&& action) const {
+        (..., action.template operator()<Ts>(_column<Ts>()));
+    }
+
+    // construct count elements from the given position in all columns (rolls back on exceptions)
+    template<typename Construct>
+    void _construct_rows(std::size_t position, std::size_t count, Construct&& construct) {
+        std::size_t constructed_columns = 0;
+        try {
+            _for_each_column([&] <typename T> (T* column) {
+                construct.template operator()<T>(column + position, count);
+                ++constructed_columns;
+            });
+        } catch (...) {
+            std::size_t column_index = 0;
+            _for_each_column([&] <typename T> (T* column) {
+                if (column_index++ < constructed_columns)
+                    std::destroy_n(column + position, count);
+            });
+            throw;
+        }
+        _size = position + count;
+    }
+
+    template<typename... Args>
+    void _emplace_at(std::size_t position, Args&&... args) {
+        auto arguments = std::forward_as_tuple(std::forward<Args>(args)...);
+        _construct_rows(position, 1, [&] <typename T> (T* data, std::size_t) {
+            constexpr std::size_t column = index_of<T>().value;
+            std::construct_at(data, std::get<column>(std::move(arguments)));
+        });
+    }
+
+    void _destroy_from(std::size_t position) noexcept {
+        _for_each_column([&] <typename T> (T* column) {
+            std::destroy(column + position, column + _size);
+        });
+        _size = position;
+    }
+
+    void _reallocate(std::size_t new_capacity) {
+        soa_vector other;
+        other._allocate(new_capacity);
+        _move_into(other);
+        other._size = _size;
+        swap(other);
+    }
+
+    // move all rows into the given (allocated) vector
+    void _move_into(soa_vector& other) noexcept {
+        _for_each_column([&] <typename T> (T* column) {
+            std::uninitialized_move_n(column, _size, other.template _column<T>());
+        });
+    }
+
+    void _allocate(std::size_t capacity) {
+        try {
+            _for_each_column([&] <typename T> (T*) {
+                auto& column = _columns.get(_columns.template index_of<T*>());
+                column = static_cast<T*>(::operator new(capacity*sizeof(T), std::align_val_t{alignment}));
+            });
+        } catch (...) {
+            _deallocate();
+            throw;
+        }
+        _capacity = capacity;
+    }
+
+    void _deallocate() noexcept {
+        _for_each_column([&] <typename T> (T*) {
+            auto& column = _columns.get(_columns.template index_of<T*>());
+            if (column)
+                ::operator delete(column, std::align_val_t{alignment});
+            column = nullptr;
+        });
+        _capacity = 0;
+    }
+
+    indexed_tuple<Ts*...> _columns;
+    std::size_t _size = 0;
+    std::size_t _capacity = 0;
+};
+
+}  // namespace cpputils
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <concepts>
+#include <type_traits>
+
+#include <cpputils/type_traits.hpp>
+#include <cpputils/utility.hpp>
+
+namespace cpputils {
+
+//! Collection of objects of a closed set of types, storing the objects of each type in a separate contiguous segment
+template<typename... Ts> requires(are_unique_v<Ts...> and sizeof...(Ts) > 0)
+class type_collection {
+ public:
+    type_collection() : _segments{std::vector<Ts>{}...} {}
+
+    //! Return the index of the segment that stores the given type
+    template<typename T>
+    static constexpr auto index_of() noexcept {
+        return indexed<Ts...>{}.template index_of<T>();
+    }
+
+    //! Insert a new object into the segment of its type
+    template<typename T> requires(contains_decayed_v<T, Ts...>)
+    void insert(T&& value) {
+        _segment<std::decay_t<T>>().push_back(std::forward<T>(value));
+    }
+
+    //! Construct a new object of type T from the given arguments
+    template<typename T, typename... Args> requires(is_any_of_v<T, Ts...>)
+    T& emplace(Args&&... args) {
+        return _segment<T>().emplace_back(std::forward<Args>(args)...);
+    }
+
+    //! Return the objects of the given type
+    template<typename T> requires(is_any_of_v<T, Ts...>)
+    std::span<T> segment() noexcept {
+        return _segment<T>();
+    }
+
+    //! Return the objects of the given type
+    template<typename T> requires(is_any_of_v<T, Ts...>)
+    std::span<const T> segment() const noexcept {
+        return _segment<T>();
+    }
+
+    //! Invoke the given action on all objects, segment by segment (the action is dispatched statically per type)
+    template<typename Action>
+    void for_each(Action&& action) {
+        (..., _for_each_in(_segment<Ts>(), action));
+    }
+
+    //! Invoke the given action on all objects, segment by segment (the action is dispatched statically per type)
+    template<typename Action>
+    void for_each(Action&& action) const {
+        (..., _for_each_in(_segment<Ts>(), action));
+    }
+
+    //! Return the total number of objects
+    std::size_t size() const noexcept {
+        return (... + _segment<Ts>().size());
+    }
+
+    //! Return the number of objects of the given type
+    template<typename T> requires(is_any_of_v<T, Ts...>)
+    std::size_t size() const noexcept {
+        return _segment<T>().size();
+    }
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    //! Reserve space for n objects of the given type
+    template<typename T> requires(is_any_of_v<T, Ts...>)
+    void reserve(std::size_t n) {
+        _segment<T>().reserve(n);
+    }
+
+    void clear() noexcept {
+        (..., _segment<Ts>().clear());
+    }
+
+ private:
+    template<typename T>
+    std::vector<T>& _segment() noexcept {
+        return _segments.get(index_of<T>());
+    }
+
+    template<typename T>
+    const std::vector<T>& _segment() const noexcept {
+        return _segments.get(index_of<T>());
+    }
+
+    template<typename Segment, typename Action>
+    static void _for_each_in(Segment& segment, Action& action) {
+        for (auto& object : segment)
+            action(object);
+    }
+
+    indexed_tuple<std::vector<Ts>...> _segments;
+};
+
+}  // namespace cpputils
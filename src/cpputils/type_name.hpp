@@ -0,0 +1,149 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <compare>
+#include <optional>
+#include <string_view>
+
+#include <cpputils/type_traits.hpp>
+#include <cpputils/utility.hpp>
+
+namespace cpputils {
+
+//! Return the 64-bit FNV-1a hash of the given characters
+constexpr std::uint64_t fnv1a_hash(std::string_view text) noexcept {
+    std::uint64_t hash = detail::fnv_offset_basis;
+    for (const char c : text) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= detail::fnv_prime;
+    }
+    return hash;
+}
+
+//! String of n characters (plus a terminating null character) that can be used as non-type template parameter,
+//! for instance in value lists: `values<fixed_string{"abc"}, fixed_string{"xyz"}>`
+template<std::size_t n>
+struct fixed_string {
+    char chars[n + 1]{};
+
+    constexpr fixed_string() noexcept = default;
+
+    constexpr fixed_string(const char (&text)[n + 1]) noexcept {
+        for (std::size_t i = 0; i < n; ++i)
+            chars[i] = text[i];
+    }
+
+    //! Construct from the first n characters of the given text (which must have at least n characters)
+    constexpr explicit fixed_string(std::string_view text) noexcept {
+        for (std::size_t i = 0; i < n; ++i)
+            chars[i] = text[i];
+    }
+
+    static constexpr std::size_t size() noexcept { return n; }
+    constexpr const char* c_str() const noexcept { return chars; }
+    constexpr std::string_view view() const noexcept { return {chars, n}; }
+    constexpr operator std::string_view() const noexcept { return view(); }
+
+    //! Return the 64-bit FNV-1a hash of the characters
+    constexpr std::uint64_t hash() const noexcept { return fnv1a_hash(view()); }
+
+    constexpr auto operator<=>(const fixed_string&) const noexcept = default;
+    constexpr bool operator==(const fixed_string&) const noexcept = default;
+};
+
+template<std::size_t n>
+fixed_string(const char (&)[n]) -> fixed_string<n - 1>;
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename T>
+    constexpr std::string_view signature_of() noexcept {
+#if defined(__clang__) || defined(__GNUC__)
+        return __PRETTY_FUNCTION__;
+#elif defined(_MSC_VER)
+        return __FUNCSIG__;
+#else
+#error "cpputils::type_name is not supported for this compiler"
+#endif
+    }
+
+    // the signature contains the type name between a prefix and a suffix that do not depend on the type
+    inline constexpr std::string_view probe_signature = signature_of<double>();
+    inline constexpr std::size_t type_name_prefix = probe_signature.find("double");
+    inline constexpr std::size_t type_name_suffix = probe_signature.size() - type_name_prefix - 6;
+
+    template<typename T>
+    constexpr auto parse_type_name() noexcept {
+        constexpr std::string_view signature = signature_of<T>();
+        constexpr std::size_t size = signature.size() - type_name_prefix - type_name_suffix;
+        return fixed_string<size>{signature.substr(type_name_prefix, size)};
+    }
+
+    // the name of each type is parsed once and stored (null-terminated) in static storage
+    template<typename T>
+    inline constexpr auto type_name_of = parse_type_name<T>();
+
+    template<typename T>
+    inline constexpr std::uint64_t type_id_of = type_name_of<T>.hash();
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+//! Return the name of the given type as spelled by the compiler (e.g. "int", "std::vector<int>" or "my::type"), at
+//! compile time and without RTTI. The spelling is compiler-specific, for instance for standard library types.
+template<typename T>
+constexpr std::string_view type_name() noexcept {
+    return detail::type_name_of<T>.view();
+}
+
+//! Return a 64-bit identifier of the given type: the FNV-1a hash of its name. Identifiers are stable across builds
+//! with the same compiler, but not across compilers that spell the name differently.
+template<typename T>
+constexpr std::uint64_t type_id() noexcept {
+    return detail::type_id_of<T>;
+}
+
+//! Table of the names and identifiers of the types in a type_list or indexed<Ts...>, computed at compile time.
+//! Lookups by index are array accesses, lookups by identifier or name use a perfect hash.
+template<typename List>
+struct type_names;
+
+template<typename... Ts> requires(are_unique_v<Ts...>)
+struct type_names<type_list<Ts...>> {
+    static constexpr std::size_t size = sizeof...(Ts);
+
+    //! The names of the types as value list of fixed_string
+    using name_values = values<detail::type_name_of<Ts>...>;
+
+    static constexpr std::array<std::string_view, size> names{type_name<Ts>()...};
+    static constexpr std::array<std::uint64_t, size> ids{type_id<Ts>()...};
+
+    static_assert(values<type_id<Ts>()...>::sort_unique().size == size, "Type identifiers must be unique");
+
+    //! Return the name of the type at the given index
+    static constexpr std::string_view name(std::size_t index) noexcept { return names[index]; }
+
+    //! Return the identifier of the type at the given index
+    static constexpr std::uint64_t id(std::size_t index) noexcept { return ids[index]; }
+
+    //! Return the index of the type with the given identifier, or nullopt if there is none
+    static constexpr std::optional<std::size_t> index_of_id(std::uint64_t id) noexcept {
+        return values<type_id<Ts>()...>::index_of(id);
+    }
+
+    //! Return the index of the type with the given name, or nullopt if there is none
+    static constexpr std::optional<std::size_t> index_of(std::string_view name) noexcept {
+        const auto index = index_of_id(fnv1a_hash(name));
+        if (index and names[*index] == name)
+            return index;
+        return std::nullopt;
+    }
+};
+
+template<typename... Ts>
+struct type_names<indexed<Ts...>> : type_names<type_list<Ts...>> {};
+
+}  // namespace cpputils
@@ -2,6 +2,8 @@
 
 #include <type_traits>
 #include <utility>
+#include <cstddef>
+#include <array>
 
 
 namespace cpputils {
@@ -77,107 +79,326 @@ struct contains_decayed<T, type_list<Ts...>> : contains_decayed<T, Ts...> {};
 template<typename T, typename... Ts>
 inline constexpr bool contains_decayed_v = contains_decayed<T, Ts...>::value;
 
+#ifndef DOXYGEN
+namespace detail {
+
+    template<std::size_t i, typename T>
+    struct indexed_type {};
+
+    //! Inherits from indexed_type<i, T> for all types (instantiated once per list of types)
+    template<typename I, typename... Ts>
+    struct indexed_types;
+    template<std::size_t... i, typename... Ts>
+    struct indexed_types<std::index_sequence<i...>, Ts...> : indexed_type<i, Ts>... {};
+    template<typename... Ts>
+    using indexed_types_t = indexed_types<std::make_index_sequence<sizeof...(Ts)>, Ts...>;
+
+    // deduction of i fails if T is the type of more than one base of the argument
+    template<typename T, std::size_t i>
+    index_constant<i> unique_index_of(const indexed_type<i, T>*);
+
+    template<std::size_t i, typename T>
+    std::type_identity<T> type_at(const indexed_type<i, T>*);
+
+    template<typename T, typename types>
+    concept occurs_once_in = requires(const types* t) {
+        { unique_index_of<T>(t) };
+    };
+
+    template<typename types, typename... Ts>
+    constexpr std::size_t first_non_unique_index() {
+        constexpr bool is_unique[] = {occurs_once_in<Ts, types>..., false};
+        std::size_t i = 0;
+        while (is_unique[i])
+            ++i;
+        return i;
+    }
+
+    template<bool found, std::size_t i, typename types>
+    struct first_duplicate_impl {};
+    template<std::size_t i, typename types>
+    struct first_duplicate_impl<true, i, types>
+    : decltype(type_at<i>(static_cast<const types*>(nullptr))) {};
+
+#if defined(__has_builtin)
+#if __has_builtin(__type_pack_element)
+#define CPPUTILS_HAVE_TYPE_PACK_ELEMENT
+#endif
+#endif
+
+#if defined(__cpp_pack_indexing)
+    template<std::size_t i, typename... Ts>
+    struct type_at_impl : std::type_identity<Ts...[i]> {};
+#elif defined(CPPUTILS_HAVE_TYPE_PACK_ELEMENT)
+    template<std::size_t i, typename... Ts>
+    struct type_at_impl : std::type_identity<__type_pack_element<i, Ts...>> {};
+#else
+    template<std::size_t i, typename... Ts>
+    struct type_at_impl : decltype(type_at<i>(static_cast<const indexed_types_t<Ts...>*>(nullptr))) {};
+#endif
+#undef CPPUTILS_HAVE_TYPE_PACK_ELEMENT
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+//! Type trait to get the type at the given index in a list of types
+template<std::size_t i, typename list>
+struct type_list_at;
+template<std::size_t i, typename... Ts> requires(i < sizeof...(Ts))
+struct type_list_at<i, type_list<Ts...>> : detail::type_at_impl<i, Ts...> {};
+template<std::size_t i, typename list>
+using type_list_at_t = typename type_list_at<i, list>::type;
+
 //! Type trait to check if all provided types are unique
-template<typename... T>
-struct are_unique;
-template<> struct are_unique<> : std::true_type {};
-template<typename T> struct are_unique<T> : std::true_type {};
-template<typename T1, typename T2> struct are_unique<T1, T2> : std::bool_constant<!std::is_same_v<T1, T2>> {};
-template<typename T1, typename T2, typename... Ts>
-struct are_unique<T1, T2, Ts...> {
-    static constexpr bool value =
-        are_unique<T1, T2>::value and
-        are_unique<T1, Ts...>::value and
-        are_unique<T2, Ts...>::value;
-};
+template<typename... Ts>
+struct are_unique : std::bool_constant<(detail::occurs_once_in<Ts, detail::indexed_types_t<Ts...>> && ...)> {};
 template<typename... T>
 struct are_unique<type_list<T...>> : are_unique<T...> {};
 template<typename... Ts>
 inline constexpr bool are_unique_v = are_unique<Ts...>::value;
 
+//! Type trait to get the first type that occurs more than once in a list of types (has no `type` if all are unique)
+template<typename... Ts>
+struct first_duplicate
+: detail::first_duplicate_impl<
+    (detail::first_non_unique_index<detail::indexed_types_t<Ts...>, Ts...>() < sizeof...(Ts)),
+    detail::first_non_unique_index<detail::indexed_types_t<Ts...>, Ts...>(),
+    detail::indexed_types_t<Ts...>
+> {};
+template<typename... Ts>
+struct first_duplicate<type_list<Ts...>> : first_duplicate<Ts...> {};
+template<typename... Ts>
+using first_duplicate_t = typename first_duplicate<Ts...>::type;
+
 
 #ifndef DOXYGEN
 namespace detail {
 
-    template<typename T, typename... Ts>
-    struct unique_types {
-        using type = std::conditional_t<
-            is_any_of_v<T, Ts...>,
-            typename unique_types<Ts...>::type,
-            typename unique_types<type_list<T>, Ts...>::type
-        >;
-    };
+    // The algorithms below are written as fold expressions over these helpers, such that
+    // the instantiation depth does not grow with the number of types.
 
     template<typename T>
-    struct unique_types<T> : std::type_identity<type_list<T>> {};
-
-    template<typename... Ts, typename T, typename... Rest>
-    struct unique_types<type_list<Ts...>, T, Rest...> {
-        using type = std::conditional_t<
-            is_any_of_v<T, Ts...>,
-            typename unique_types<type_list<Ts...>, Rest...>::type,
-            typename unique_types<type_list<Ts..., T>, Rest...>::type
-        >;
+    struct type_tag {};
+
+    template<typename list>
+    struct type_list_merger {
+        using type = list;
     };
+    template<typename... As, typename... Bs>
+    type_list_merger<type_list<As..., Bs...>> operator+(type_list_merger<type_list<As...>>,
+                                                        type_list_merger<type_list<Bs...>>);
 
     template<typename... Ts>
-    struct unique_types<type_list<Ts...>> : std::type_identity<type_list<Ts...>> {};
-
-    template<typename A, typename B>
-    struct merged_types;
-
-    template<typename... As, typename... Bs>
-    struct merged_types<type_list<As...>, type_list<Bs...>> {
-        using type = type_list<As..., Bs...>;
+    struct unique_type_set : type_tag<Ts>... {
+        using type = type_list<Ts...>;
     };
+    template<typename... Ts, typename T>
+    std::conditional_t<
+        std::is_base_of_v<type_tag<T>, unique_type_set<Ts...>>,
+        unique_type_set<Ts...>,
+        unique_type_set<Ts..., T>
+    > operator+(unique_type_set<Ts...>, type_tag<T>);
+
+    template<typename... Ts>
+    struct unique_types : std::type_identity<
+        typename decltype((unique_type_set<>{} + ... + type_tag<Ts>{}))::type
+    > {};
 
 }  // namespace detail
 #endif  // DOXYGEN
 
-//! Type trait to make a list of unique types from a list of types
+//! Type trait to make a list of unique types from a list of types (keeps the order of first occurrence)
 template<typename T, typename... Ts>
 struct unique : detail::unique_types<T, Ts...> {};
-template<typename... Ts> requires(sizeof...(Ts) > 0)
+template<typename... Ts>
 struct unique<type_list<Ts...>> : detail::unique_types<Ts...> {};
-template<>
-struct unique<type_list<>> : std::type_identity<type_list<>> {};
 template<typename A, typename... Ts>
 using unique_t = typename unique<A, Ts...>::type;
 
-//! Type trait to merge two lists of types
+//! Type trait to merge lists of types
 template<typename A, typename... Ts>
-struct merged : detail::merged_types<A, Ts...> {};
+struct merged : std::type_identity<
+    typename decltype((detail::type_list_merger<A>{} + ... + detail::type_list_merger<Ts>{}))::type
+> {};
 template<typename A, typename... Ts>
 using merged_t = typename merged<A, Ts...>::type;
 
+//! Type trait to filter types by a given predicate (keeps the order of the types)
+template<template<typename> typename filter, typename... Ts>
+struct filtered : merged<type_list<>, std::conditional_t<filter<Ts>::value, type_list<Ts>, type_list<>>...> {};
+template<template<typename> typename filter, typename... Ts>
+struct filtered<filter, type_list<Ts...>> : filtered<filter, Ts...> {};
+template<template<typename> typename filter, typename... Ts>
+using filtered_t = typename filtered<filter, Ts...>::type;
+
 
 #ifndef DOXYGEN
 namespace detail {
 
-    template<template<typename> typename filter, typename...>
-    struct filtered_types_impl;
-    template<template<typename> typename filter, typename T, typename... rest, typename... current>
-    struct filtered_types_impl<filter, type_list<T, rest...>, type_list<current...>> {
-        using type = std::conditional_t<
-            filter<T>::value,
-            typename filtered_types_impl<filter, type_list<rest...>, merged_t<type_list<T>, type_list<current...>>>::type,
-            typename filtered_types_impl<filter, type_list<rest...>, type_list<current...>>::type
-        >;
+    // same as std::less<>, which would require the (heavy) <functional> header
+    struct less {
+        template<typename A, typename B>
+        constexpr bool operator()(const A& a, const B& b) const noexcept(noexcept(a < b)) {
+            return a < b;
+        }
     };
-    template<template<typename> typename filter, typename... current>
-    struct filtered_types_impl<filter, type_list<>, type_list<current...>> {
-        using type = type_list<current...>;
+
+    // stable bottom-up merge sort, usable in constant expressions with few evaluation steps per comparison
+    template<typename T, std::size_t n, typename Less>
+    constexpr void stable_sort(std::array<T, n>& values, const Less& less) {
+        std::array<T, n> buffer{};
+        std::array<T, n>* from = &values;
+        std::array<T, n>* to = &buffer;
+        for (std::size_t width = 1; width < n; width *= 2) {
+            for (std::size_t begin = 0; begin < n; begin += 2*width) {
+                const std::size_t middle = begin + width < n ? begin + width : n;
+                const std::size_t end = begin + 2*width < n ? begin + 2*width : n;
+                std::size_t i = begin, j = middle, k = begin;
+                while (i < middle && j < end)
+                    (*to)[k++] = less((*from)[j], (*from)[i]) ? (*from)[j++] : (*from)[i++];
+                while (i < middle)
+                    (*to)[k++] = (*from)[i++];
+                while (j < end)
+                    (*to)[k++] = (*from)[j++];
+            }
+            std::swap(from, to);
+        }
+        if (from != &values)
+            values = *from;
+    }
+
+    // stable ordering of the indices 0...n-1 by the given keys
+    template<typename Compare, typename K, std::size_t n>
+    constexpr std::array<std::size_t, n> sorted_indices(const std::array<K, n>& keys) {
+        std::array<std::size_t, n> indices{};
+        for (std::size_t i = 0; i < n; ++i)
+            indices[i] = i;
+        stable_sort(indices, [&] (std::size_t a, std::size_t b) { return Compare{}(keys[a], keys[b]); });
+        return indices;
+    }
+
+    template<template<typename> typename key, typename Compare, typename... Ts>
+    struct sorted_types {
+        static constexpr auto order = sorted_indices<Compare>(
+            std::array<std::remove_cvref_t<decltype(key<first_t<Ts...>>::value)>, sizeof...(Ts)>{key<Ts>::value...}
+        );
+
+        template<std::size_t... i>
+        static type_list<typename type_at_impl<order[i], Ts...>::type...> select(const std::index_sequence<i...>&);
+
+        using type = decltype(select(std::make_index_sequence<sizeof...(Ts)>{}));
     };
+    template<template<typename> typename key, typename Compare>
+    struct sorted_types<key, Compare> : std::type_identity<type_list<>> {};
 
 }  // namespace detail
 #endif  // DOXYGEN
 
-//! Type trait to filter types by a given predicate
-template<template<typename> typename filter, typename... Ts>
-struct filtered : detail::filtered_types_impl<filter, type_list<Ts...>, type_list<>> {};
-template<template<typename> typename filter, typename... Ts>
-struct filtered<filter, type_list<Ts...>> : detail::filtered_types_impl<filter, type_list<Ts...>, type_list<>> {};
-template<template<typename> typename filter, typename... Ts>
-using filtered_t = typename filtered<filter, Ts...>::type;
+//! Type trait to sort types by the compile-time key `key<T>::value` (e.g. std::alignment_of), in the order given by
+//! Compare and keeping the order of types with equivalent keys. Instantiates the key once per type and sorts the keys
+//! in O(N log N) constant-evaluation steps.
+template<template<typename> typename key, typename Compare, typename... Ts>
+struct sorted : detail::sorted_types<key, Compare, Ts...> {};
+template<template<typename> typename key, typename Compare, typename... Ts>
+struct sorted<key, Compare, type_list<Ts...>> : sorted<key, Compare, Ts...> {};
+template<template<typename> typename key, typename Compare, typename... Ts>
+using sorted_t = typename sorted<key, Compare, Ts...>::type;
+
+
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<template<typename> typename trait>
+    struct trait_tag {};
+
+    template<template<typename> typename trait, typename... Ts>
+    inline constexpr std::array<bool, sizeof...(Ts)> trait_row{trait<Ts>::value...};
+
+    // sets of types with membership test via std::is_base_of<type_tag<T>, set>
+    template<typename... Ts>
+    struct type_set : type_tag<Ts>... {};
+
+    // (also supports duplicate types, as std::is_base_of is true for ambiguous bases, but is slower to query)
+    template<std::size_t i, typename T>
+    struct indexed_type_tag : type_tag<T> {};
+    template<typename I, typename... Ts>
+    struct indexed_type_set;
+    template<std::size_t... i, typename... Ts>
+    struct indexed_type_set<std::index_sequence<i...>, Ts...> : indexed_type_tag<i, Ts>... {};
+
+    template<typename... Ts>
+    using type_set_t = std::conditional_t<
+        are_unique_v<Ts...>,
+        type_set<Ts...>,
+        indexed_type_set<std::make_index_sequence<sizeof...(Ts)>, Ts...>
+    >;
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+//! Evaluates the given traits once for all types of a list, and stores the results in a constexpr table.
+//! Queries for (trait, type) pairs, as well as membership tests for types, are lookups that do not instantiate
+//! further traits or disjunctions over the list.
+template<typename list, template<typename> typename... traits>
+struct trait_table;
+template<typename... Ts, template<typename> typename... traits> requires(are_unique_v<Ts...>)
+struct trait_table<type_list<Ts...>, traits...> {
+ private:
+    using types = detail::indexed_types_t<Ts...>;
+    using trait_indices = detail::indexed_types_t<detail::trait_tag<traits>...>;
+    using type_set = detail::type_set<Ts...>;
+    using decayed_type_set = detail::type_set_t<std::decay_t<Ts>...>;
+
+ public:
+    //! The results of all traits (rows) for all types (columns)
+    static constexpr std::array<std::array<bool, sizeof...(Ts)>, sizeof...(traits)> results{
+        detail::trait_row<traits, Ts...>...
+    };
+
+    //! Return true if the given type is contained in the list (same as is_any_of)
+    template<typename T>
+    static constexpr bool contains() noexcept {
+        return std::is_base_of<detail::type_tag<T>, type_set>::value;
+    }
+
+    //! Return true if the decay_t of the given type matches the decay_t of any type in the list (same as contains_decayed)
+    template<typename T>
+    static constexpr bool contains_decayed() noexcept {
+        return std::is_base_of<detail::type_tag<std::decay_t<T>>, decayed_type_set>::value;
+    }
+
+    //! Return the position of the given type in the list
+    template<typename T> requires(std::is_base_of<detail::type_tag<T>, type_set>::value)
+    static constexpr std::size_t index_of() noexcept {
+        return decltype(detail::unique_index_of<T>(static_cast<const types*>(nullptr)))::value;
+    }
+
+    //! Return the position of the given trait in the list of traits
+    template<template<typename> typename trait>
+    static constexpr std::size_t trait_index() noexcept {
+        return decltype(detail::unique_index_of<detail::trait_tag<trait>>(static_cast<const trait_indices*>(nullptr)))::value;
+    }
+
+    //! Return the result of the given trait for the given type
+    template<template<typename> typename trait, typename T>
+    static constexpr bool value() noexcept {
+        return results[trait_index<trait>()][index_of<T>()];
+    }
+
+    //! Return the number of types in the list for which the given trait is true
+    template<template<typename> typename trait>
+    static constexpr std::size_t count() noexcept {
+        std::size_t result = 0;
+        for (const bool r : results[trait_index<trait>()])
+            result += r ? 1 : 0;
+        return result;
+    }
+
+    //! Return the result of the trait with the given index for the type at the given index (at runtime)
+    static constexpr bool at(std::size_t trait, std::size_t type) noexcept {
+        return results[trait][type];
+    }
+};
 
 }  // namespace cpputils
@@ -3,7 +3,15 @@
 #include <type_traits>
 #include <concepts>
 #include <utility>
-#include <ostream>
+#include <tuple>
+#include <optional>
+#include <cstdint>
+#include <limits>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <new>
 
 #include <cpputils/type_traits.hpp>
 
@@ -26,12 +34,234 @@ public:
     constexpr const auto& get() const & noexcept { return _value; }
 
 private:
-    stored_t _value;
+    [[no_unique_address]] stored_t _value;
 };
 
 template<typename T>
 value_or_reference(T&&) -> value_or_reference<T>;
 
+#ifndef DOXYGEN
+namespace detail {
+
+    // fixed instead of std::hardware_destructive_interference_size, which is not ABI-stable (and gcc warns about it)
+    inline constexpr std::size_t cache_line_size = 64;
+
+    // parameters of the 64-bit FNV-1a hash
+    inline constexpr std::uint64_t fnv_offset_basis = 14695981039346656037ull;
+    inline constexpr std::uint64_t fnv_prime = 1099511628211ull;
+
+    // like std::addressof, but without including <memory>
+    template<typename T>
+    void* address_of(T& value) noexcept {
+        return const_cast<void*>(static_cast<const volatile void*>(
+            &const_cast<char&>(reinterpret_cast<const volatile char&>(value))
+        ));
+    }
+
+    // number of instances per thread whose values an instance_cache holds
+    inline constexpr std::size_t instance_cache_size = 8;
+
+    // thread-local cache of per-instance values (e.g. the thread's shard of an instance), keyed by instance ids that
+    // are never reused (unlike addresses). Instances whose ids collide share a slot and recreate the value on access.
+    template<typename T>
+    struct instance_cache {
+        struct entry {
+            std::uint64_t owner = 0;
+            T value{};
+        };
+
+        template<typename Make>
+        T& get(std::uint64_t owner, Make&& make) noexcept(noexcept(make())) {
+            entry& e = entries[owner%instance_cache_size];
+            if (e.owner != owner) {
+                e.value = make();
+                e.owner = owner;
+            }
+            return e.value;
+        }
+
+        std::array<entry, instance_cache_size> entries{};
+    };
+
+    // operations on a callable stored (as value_or_reference) in the buffer of an inplace_function
+    template<typename R, typename... Args>
+    struct inplace_function_vtable {
+        R (*invoke)(void*, Args&&...);
+        void (*copy)(const void*, void*);  // nullptr if the buffer can be copied bytewise
+        void (*move)(void*, void*);        // nullptr if the buffer can be copied bytewise
+        void (*destroy)(void*) noexcept;   // nullptr if the stored object is trivially destructible
+    };
+
+    template<typename Stored, typename R, typename... Args>
+    inline constexpr inplace_function_vtable<R, Args...> inplace_function_vtable_for{
+        .invoke = [] (void* buffer, Args&&... args) -> R {
+            return static_cast<R>(std::launder(static_cast<Stored*>(buffer))->get()(std::forward<Args>(args)...));
+        },
+        .copy = std::is_trivially_copyable_v<Stored> ? nullptr : +[] (const void* source, void* target) {
+            ::new (target) Stored{*std::launder(static_cast<const Stored*>(source))};
+        },
+        .move = std::is_trivially_copyable_v<Stored> ? nullptr : +[] (void* source, void* target) {
+            ::new (target) Stored{std::move(*std::launder(static_cast<Stored*>(source)))};
+        },
+        .destroy = std::is_trivially_destructible_v<Stored> ? nullptr : +[] (void* buffer) noexcept {
+            std::launder(static_cast<Stored*>(buffer))->~Stored();
+        }
+    };
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+template<typename Signature, std::size_t capacity = 4*sizeof(void*)>
+class inplace_function;
+
+//! Type-erased callable with the given signature, stored in a buffer of the given capacity (in bytes) without ever
+//! allocating on the heap. Like value_or_reference, it stores a callable given as rvalue by value, and one given
+//! as lvalue by reference (pass a copy or std::move it to store it by value). Callables that do not fit into the
+//! buffer are rejected at compile time. Calling an empty inplace_function is undefined behaviour.
+template<typename R, typename... Args, std::size_t capacity>
+class inplace_function<R(Args...), capacity> {
+    template<typename F>
+    using stored_t = value_or_reference<F>;
+
+    using vtable = detail::inplace_function_vtable<R, Args...>;
+
+ public:
+    //! True if a callable of the given type (as passed to the constructor) fits into the buffer
+    template<typename F>
+    static constexpr bool fits = sizeof(stored_t<F>) <= capacity and alignof(stored_t<F>) <= alignof(std::max_align_t);
+
+    inplace_function() noexcept = default;
+
+    template<typename F>
+        requires(!std::is_same_v<std::remove_cvref_t<F>, inplace_function> and
+                 std::is_invocable_r_v<R, typename stored_t<F>::stored_t&, Args...> and
+                 std::is_copy_constructible_v<stored_t<F>> and
+                 std::is_nothrow_move_constructible_v<stored_t<F>> and
+                 fits<F>)
+    inplace_function(F&& f) noexcept(std::is_nothrow_constructible_v<stored_t<F>, F>)
+    : _vtable{&detail::inplace_function_vtable_for<stored_t<F>, R, Args...>} {
+        ::new (static_cast<void*>(_buffer)) stored_t<F>{std::forward<F>(f)};
+    }
+
+    inplace_function(const inplace_function& other) {
+        _copy_from(other);
+    }
+
+    //! The moved-from function is empty afterwards
+    inplace_function(inplace_function&& other) noexcept {
+        _move_from(other);
+    }
+
+    inplace_function& operator=(const inplace_function& other) {
+        if (this != &other) {
+            _reset();
+            _copy_from(other);
+        }
+        return *this;
+    }
+
+    inplace_function& operator=(inplace_function&& other) noexcept {
+        if (this != &other) {
+            _reset();
+            _move_from(other);
+        }
+        return *this;
+    }
+
+    ~inplace_function() noexcept {
+        _reset();
+    }
+
+    //! Invoke the stored callable (requires a stored callable)
+    R operator()(Args... args) const {
+        return _vtable->invoke(_buffer, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept {
+        return _vtable != nullptr;
+    }
+
+ private:
+    void _copy_from(const inplace_function& other) {
+        if (other._vtable && other._vtable->copy)
+            other._vtable->copy(other._buffer, _buffer);
+        else if (other._vtable)
+            _copy_bytes(other._buffer, _buffer);
+        _vtable = other._vtable;
+    }
+
+    void _move_from(inplace_function& other) noexcept {
+        if (other._vtable && other._vtable->move)
+            other._vtable->move(other._buffer, _buffer);
+        else if (other._vtable)
+            _copy_bytes(other._buffer, _buffer);
+        _vtable = other._vtable;
+        other._reset();
+    }
+
+    static void _copy_bytes(const std::byte* from, std::byte* to) noexcept {
+        for (std::size_t i = 0; i < capacity; ++i)
+            to[i] = from[i];
+    }
+
+    void _reset() noexcept {
+        if (_vtable && _vtable->destroy)
+            _vtable->destroy(_buffer);
+        _vtable = nullptr;
+    }
+
+    const vtable* _vtable = nullptr;
+    alignas(std::max_align_t) mutable std::byte _buffer[capacity];
+};
+
+template<typename Signature>
+class function_ref;
+
+//! Non-owning reference to a callable with the given signature. It is cheap to copy (two pointers),
+//! and the referenced callable must outlive it.
+template<typename R, typename... Args>
+class function_ref<R(Args...)> {
+ public:
+    template<typename F>
+        requires(!std::is_same_v<std::remove_cvref_t<F>, function_ref> and
+                 std::is_invocable_r_v<R, F&, Args...>)
+    function_ref(F&& f) noexcept {
+        using T = std::remove_reference_t<F>;
+        using P = std::remove_cvref_t<F>;
+        if constexpr (std::is_function_v<T>) {
+            _callable.function = reinterpret_cast<void(*)()>(&f);
+            _invoke = [] (callable c, Args&&... args) -> R {
+                return static_cast<R>(reinterpret_cast<T*>(c.function)(std::forward<Args>(args)...));
+            };
+        } else if constexpr (std::is_pointer_v<P> and std::is_function_v<std::remove_pointer_t<P>>) {
+            // function pointers are stored by value, as they may be temporaries (e.g. &function)
+            _callable.function = reinterpret_cast<void(*)()>(f);
+            _invoke = [] (callable c, Args&&... args) -> R {
+                return static_cast<R>(reinterpret_cast<P>(c.function)(std::forward<Args>(args)...));
+            };
+        } else {
+            _callable.object = detail::address_of(f);
+            _invoke = [] (callable c, Args&&... args) -> R {
+                return static_cast<R>((*static_cast<T*>(c.object))(std::forward<Args>(args)...));
+            };
+        }
+    }
+
+    R operator()(Args... args) const {
+        return _invoke(_callable, std::forward<Args>(args)...);
+    }
+
+ private:
+    union callable {
+        void* object;
+        void (*function)();
+    };
+
+    callable _callable;
+    R (*_invoke)(callable, Args&&...);
+};
+
+
 
 #ifndef DOXYGEN
 namespace detail {
@@ -62,7 +292,9 @@ namespace detail {
 
 //! A list of unique types, where each type is assigned a unique index
 template<typename... Ts> requires(are_unique_v<Ts...>)
-struct indexed : detail::indexed<std::make_index_sequence<sizeof...(Ts)>, Ts...> {};
+struct indexed : detail::indexed<std::make_index_sequence<sizeof...(Ts)>, Ts...> {
+    static constexpr std::size_t size = sizeof...(Ts);
+};
 
 
 #ifndef DOXYGEN
@@ -82,7 +314,7 @@ namespace detail {
         constexpr auto& get(const index&) noexcept { return _storage.get(); }
 
     private:
-        value_or_reference<T> _storage;
+        [[no_unique_address]] value_or_reference<T> _storage;
     };
 
     template<typename... Ts>
@@ -97,99 +329,530 @@ namespace detail {
 }  // namespace detail
 #endif  // DOXYGEN
 
-//! Stores a set unique types by reference or value and provides access to them via unique indices
+//! Stores a set unique types by reference or value and provides access to them via unique indices.
+//! Empty types do not occupy any space, the remaining elements are stored in the given order.
 template<typename... Ts> requires(are_unique_v<Ts...>)
 struct indexed_tuple : detail::indexed_tuple<std::make_index_sequence<sizeof...(Ts)>, Ts...> {
  private:
     using base = detail::indexed_tuple<std::make_index_sequence<sizeof...(Ts)>, Ts...>;
 
  public:
+    static constexpr std::size_t size = sizeof...(Ts);
+
     constexpr indexed_tuple(Ts... ts) noexcept : base(std::forward<Ts>(ts)...) {}
 };
 
 template<typename... Ts>
 indexed_tuple(Ts&&...) -> indexed_tuple<Ts...>;
 
+
 #ifndef DOXYGEN
 namespace detail {
 
-    template<std::size_t i, auto v>
-    struct value_i {
-        static constexpr auto at(index_constant<i>) noexcept {
-            return v;
+    //! Storage order of the given types that sorts them by decreasing alignment (stable w.r.t. equal alignments)
+    template<typename... Ts>
+    inline constexpr std::array<std::size_t, sizeof...(Ts)> alignment_sorted_order = [] () {
+        constexpr std::array<std::size_t, sizeof...(Ts)> alignments{alignof(value_or_reference<Ts>)...};
+        std::array<std::size_t, sizeof...(Ts)> order{};
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            std::size_t j = i;
+            for (; j > 0 && alignments[order[j-1]] < alignments[i]; --j)
+                order[j] = order[j-1];
+            order[j] = i;
         }
+        return order;
+    } ();
+
+    template<typename I, typename... Ts>
+    struct packed_indexed_tuple_base;
+    template<std::size_t... k, typename... Ts>
+    struct packed_indexed_tuple_base<std::index_sequence<k...>, Ts...> : std::type_identity<
+        indexed_tuple<
+            std::index_sequence<alignment_sorted_order<Ts...>[k]...>,
+            type_list_at_t<alignment_sorted_order<Ts...>[k], type_list<Ts...>>...
+        >
+    > {};
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+//! Same as indexed_tuple, but the elements are stored in the order of decreasing alignment to minimize padding.
+//! The logical indices of the elements (see index_of) are the same as for indexed_tuple.
+template<typename... Ts> requires(are_unique_v<Ts...>)
+struct packed_indexed_tuple
+: detail::packed_indexed_tuple_base<std::make_index_sequence<sizeof...(Ts)>, Ts...>::type {
+ private:
+    using base = typename detail::packed_indexed_tuple_base<std::make_index_sequence<sizeof...(Ts)>, Ts...>::type;
+
+    template<std::size_t... k, typename Args>
+    constexpr packed_indexed_tuple(const std::index_sequence<k...>&, Args&& args) noexcept
+    : base(std::get<detail::alignment_sorted_order<Ts...>[k]>(std::move(args))...)
+    {}
+
+ public:
+    static constexpr std::size_t size = sizeof...(Ts);
+
+    constexpr packed_indexed_tuple(Ts... ts) noexcept
+    : packed_indexed_tuple(std::make_index_sequence<sizeof...(Ts)>{}, std::forward_as_tuple(std::forward<Ts>(ts)...))
+    {}
+};
+
+template<typename... Ts>
+packed_indexed_tuple(Ts&&...) -> packed_indexed_tuple<Ts...>;
+
+//! Type trait to check if a type is an indexed_tuple (or packed_indexed_tuple)
+template<typename T>
+struct is_indexed_tuple : std::false_type {};
+template<typename... Ts>
+struct is_indexed_tuple<indexed_tuple<Ts...>> : std::true_type {};
+template<typename... Ts>
+struct is_indexed_tuple<packed_indexed_tuple<Ts...>> : std::true_type {};
+template<typename T>
+inline constexpr bool is_indexed_tuple_v = is_indexed_tuple<T>::value;
+
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename R, typename Action, std::size_t i>
+    constexpr R invoke_with_index(Action&& action) {
+        return std::forward<Action>(action)(index_constant<i>{});
+    }
+
+    template<typename R, typename Action, typename indices>
+    struct index_dispatch_table;
+    template<typename R, typename Action, std::size_t... i>
+    struct index_dispatch_table<R, Action, std::index_sequence<i...>> {
+        static constexpr R (*functions[])(Action&&) = {&invoke_with_index<R, Action, i>...};
     };
 
-    template<typename I, auto...>
-    struct values;
-    template<std::size_t... i, auto... v> requires(sizeof...(i) == sizeof...(v))
-    struct values<std::index_sequence<i...>, v...> : value_i<i, v>... {
-        using value_i<i, v>::at...;
+    template<typename Action, typename indices>
+    inline constexpr bool same_result_for_all_indices = false;
+    template<typename Action, std::size_t... i>
+    inline constexpr bool same_result_for_all_indices<Action, std::index_sequence<i...>> = (
+        std::is_same_v<std::invoke_result_t<Action, index_constant<0>>, std::invoke_result_t<Action, index_constant<i>>>
+        and ...
+    );
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+//! Invoke the given action with the index_constant that corresponds to the given runtime index (requires i < n).
+//! This is a single indirect call through a table of function pointers, independent of n. The action must return
+//! the same type for all indices.
+template<std::size_t n, typename Action> requires(n > 0)
+constexpr decltype(auto) with_index(std::size_t i, Action&& action) {
+    using R = std::invoke_result_t<Action, index_constant<0>>;
+    static_assert(detail::same_result_for_all_indices<Action, std::make_index_sequence<n>>,
+                  "The action must return the same type for all indices");
+    if constexpr (n == 1)
+        return std::forward<Action>(action)(index_constant<0>{});
+    else
+        return detail::index_dispatch_table<R, Action, std::make_index_sequence<n>>::functions[i](
+            std::forward<Action>(action)
+        );
+}
+
+//! Invoke the given action with the index_constants 0...n-1 (in that order), without a runtime loop
+template<std::size_t n, typename Action>
+constexpr void static_for(Action&& action) {
+    [&] <std::size_t... i> (const std::index_sequence<i...>&) {
+        (..., action(index_constant<i>{}));
+    }(std::make_index_sequence<n>{});
+}
+
+//! Invoke the given action with the element at the given runtime index in the given indexed_tuple (requires i < size).
+//! The action must return the same type for all elements.
+template<typename Tuple, typename Action> requires(is_indexed_tuple_v<std::remove_cvref_t<Tuple>>)
+constexpr decltype(auto) visit(Tuple&& tuple, std::size_t i, Action&& action) {
+    return with_index<std::remove_cvref_t<Tuple>::size>(i, [&] (auto index) -> decltype(auto) {
+        return std::forward<Action>(action)(tuple.get(index));
+    });
+}
+
+//! Invoke the given action on all elements of the given indexed_tuple (in the order of their indices)
+template<typename Tuple, typename Action> requires(is_indexed_tuple_v<std::remove_cvref_t<Tuple>>)
+constexpr void for_each(Tuple&& tuple, Action&& action) {
+    [&] <std::size_t... i> (const std::index_sequence<i...>&) {
+        (..., action(tuple.get(index_constant<i>{})));
+    }(std::make_index_sequence<std::remove_cvref_t<Tuple>::size>{});
+}
+
+//! Return an indexed_tuple that contains the results of invoking the given action on all elements of the given tuple.
+//! Since the types of an indexed_tuple are unique, the action must return a different type for each element (e.g.
+//! mapping all elements to std::size_t is not possible, use for_each or visit instead).
+template<typename Tuple, typename Action> requires(is_indexed_tuple_v<std::remove_cvref_t<Tuple>>)
+constexpr auto transform(Tuple&& tuple, Action&& action) {
+    return [&] <std::size_t... i> (const std::index_sequence<i...>&) {
+        constexpr bool unique_results = are_unique_v<decltype(action(tuple.get(index_constant<i>{})))...>;
+        static_assert(unique_results, "The action must return a different type for each element of the tuple");
+        if constexpr (unique_results)
+            return indexed_tuple{action(tuple.get(index_constant<i>{}))...};
+    }(std::make_index_sequence<std::remove_cvref_t<Tuple>::size>{});
+}
+
+template<auto... v>
+struct values;
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<auto v>
+    struct value_holder {
+        static constexpr auto value = v;
     };
 
+    template<std::size_t i, auto... v>
+    inline constexpr auto value_at = type_list_at_t<i, type_list<value_holder<v>...>>::value;
+
     template<auto... v>
-    struct value_list_helper {};
+    inline constexpr bool have_same_type = true;
+    template<auto v0, auto... v>
+    inline constexpr bool have_same_type<v0, v...> = (std::is_same_v<decltype(v0), decltype(v)> && ...);
+
+    template<std::size_t max>
+    using smallest_unsigned_t = std::conditional_t<(max <= std::numeric_limits<std::uint8_t>::max()), std::uint8_t,
+                                std::conditional_t<(max <= std::numeric_limits<std::uint16_t>::max()), std::uint16_t,
+                                std::conditional_t<(max <= std::numeric_limits<std::uint32_t>::max()), std::uint32_t,
+                                std::uint64_t>>>;
+
+    // finalizer of splitmix64
+    constexpr std::uint64_t mix(std::uint64_t x) noexcept {
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+
+    template<typename T>
+    constexpr std::uint64_t hash_key(const T& key) noexcept {
+        if constexpr (std::is_enum_v<T>)
+            return mix(static_cast<std::uint64_t>(static_cast<std::underlying_type_t<T>>(key)));
+        else
+            return mix(static_cast<std::uint64_t>(key));
+    }
+
+    // not constexpr, such that failing to construct a perfect hash table (at compile time) is a compile error
+    inline void perfect_hash_construction_failed() {}
+
+    //! Perfect hash ("hash and displace") of the given keys to their index in the list of keys
+    template<auto... keys>
+    class perfect_hash_index {
+        using key_type = first_t<decltype(keys)...>;
+        using index_type = smallest_unsigned_t<sizeof...(keys)>;
+        static constexpr std::size_t size = sizeof...(keys);
+        static constexpr std::size_t slot_count = std::bit_ceil(2*size);
+        static constexpr std::size_t bucket_count = std::bit_ceil(size/2 + 1);
+        static constexpr index_type empty = size;
+
+        struct table {
+            std::array<std::uint32_t, bucket_count> displacements{};
+            std::array<index_type, slot_count> indices{};
+            std::array<key_type, slot_count> slot_keys{};
+        };
+
+        static constexpr std::size_t _bucket(std::uint64_t hash) noexcept {
+            return (hash >> 32) & (bucket_count - 1);
+        }
+
+        static constexpr std::size_t _slot(std::uint64_t hash, std::uint32_t displacement) noexcept {
+            return ((hash ^ displacement)*0x9e3779b97f4a7c15ull) >> (64 - std::countr_zero(slot_count));
+        }
+
+        static constexpr table _make_table() {
+            constexpr std::array<key_type, size> key_list{keys...};
+            std::array<std::uint64_t, size> hashes{};
+            std::array<std::size_t, bucket_count + 1> bucket_begin{};
+            for (std::size_t i = 0; i < size; ++i) {
+                hashes[i] = hash_key(key_list[i]);
+                bucket_begin[_bucket(hashes[i]) + 1]++;
+            }
+
+            // sort the keys by bucket and the buckets by size, largest first
+            std::size_t max_bucket_size = 0;
+            for (std::size_t b = 0; b < bucket_count; ++b) {
+                if (bucket_begin[b + 1] > max_bucket_size)
+                    max_bucket_size = bucket_begin[b + 1];
+                bucket_begin[b + 1] += bucket_begin[b];
+            }
+            std::array<std::size_t, size> keys_by_bucket{};
+            std::array<std::size_t, bucket_count> bucket_fill{};
+            for (std::size_t i = 0; i < size; ++i) {
+                const auto b = _bucket(hashes[i]);
+                keys_by_bucket[bucket_begin[b] + bucket_fill[b]++] = i;
+            }
+            std::array<std::size_t, bucket_count> buckets_by_size{};
+            std::size_t sorted = 0;
+            for (std::size_t bucket_size = max_bucket_size; bucket_size > 0; --bucket_size)
+                for (std::size_t b = 0; b < bucket_count; ++b)
+                    if (bucket_fill[b] == bucket_size)
+                        buckets_by_size[sorted++] = b;
+
+            table result;
+            result.indices.fill(empty);
+            std::array<std::size_t, size> candidate_slots{};
+            for (std::size_t sorted_index = 0; sorted_index < sorted; ++sorted_index) {
+                const auto b = buckets_by_size[sorted_index];
+                const auto first = keys_by_bucket.begin() + bucket_begin[b];
+
+                // equal keys end up in the same bucket, we only store the first of them
+                auto last = first;
+                for (auto it = first; it != first + bucket_fill[b]; ++it) {
+                    bool is_duplicate = false;
+                    for (auto other = first; other != last; ++other)
+                        is_duplicate = is_duplicate || key_list[*other] == key_list[*it];
+                    if (!is_duplicate)
+                        *last++ = *it;
+                }
+
+                for (std::uint32_t displacement = 0; ; ++displacement) {
+                    if (displacement == std::numeric_limits<std::uint32_t>::max())
+                        perfect_hash_construction_failed();
+
+                    bool success = true;
+                    for (auto it = first; it != last && success; ++it) {
+                        const auto slot = _slot(hashes[*it], displacement);
+                        const auto taken = candidate_slots.begin() + (it - first);
+                        success = result.indices[slot] == empty;
+                        for (auto other = candidate_slots.begin(); other != taken && success; ++other)
+                            success = *other != slot;
+                        *taken = slot;
+                    }
+                    if (success) {
+                        for (auto it = first; it != last; ++it) {
+                            result.indices[candidate_slots[it - first]] = static_cast<index_type>(*it);
+                            result.slot_keys[candidate_slots[it - first]] = key_list[*it];
+                        }
+                        result.displacements[b] = displacement;
+                        break;
+                    }
+                }
+            }
+            return result;
+        }
+
+        static constexpr table _table = _make_table();
+
+     public:
+        static constexpr std::optional<std::size_t> index_of(const key_type& key) noexcept {
+            const auto hash = hash_key(key);
+            const auto slot = _slot(hash, _table.displacements[_bucket(hash)]);
+            if (_table.indices[slot] != empty && _table.slot_keys[slot] == key)
+                return _table.indices[slot];
+            return std::nullopt;
+        }
+    };
 
-    template<std::size_t i, std::size_t n, auto... values>
-    struct drop_n;
-    template<std::size_t i, std::size_t n, auto v0, auto... v> requires(i < n)
-    struct drop_n<i, n, v0, v...> : drop_n<i+1, n, v...> {};
-    template<std::size_t i, std::size_t n, auto... v> requires(i == n)
-    struct drop_n<i, n, v...> : std::type_identity<value_list_helper<v...>> {};
+    // sorted copy of the given values (without duplicates if unique = true), and the number of values in it
+    template<typename Compare, bool unique, typename T, std::size_t n>
+    constexpr std::pair<std::array<T, n>, std::size_t> sort_values(std::array<T, n> values) {
+        stable_sort(values, Compare{});
+        if constexpr (unique) {
+            std::size_t size = 0;
+            for (std::size_t i = 0; i < n; ++i)
+                if (size == 0 || Compare{}(values[size - 1], values[i]) || Compare{}(values[i], values[size - 1]))
+                    values[size++] = values[i];
+            return {values, size};
+        } else {
+            return {values, n};
+        }
+    }
+
+    enum class set_operation { union_of, intersection_of, difference_of };
+
+    template<set_operation op, typename T, std::size_t n, std::size_t m>
+    constexpr std::pair<std::array<T, n + m>, std::size_t> apply(const std::array<T, n>& a, const std::array<T, m>& b) {
+        const auto [lhs, lhs_size] = sort_values<less, true>(a);
+        const auto [rhs, rhs_size] = sort_values<less, true>(b);
+        std::array<T, n + m> result{};
+        std::size_t i = 0, j = 0, size = 0;
+        // merge of the sorted lists as in std::set_union (and the others), which would require <algorithm>
+        while (i < lhs_size && j < rhs_size) {
+            if (less{}(lhs[i], rhs[j])) {
+                if constexpr (op != set_operation::intersection_of)
+                    result[size++] = lhs[i];
+                ++i;
+            } else if (less{}(rhs[j], lhs[i])) {
+                if constexpr (op == set_operation::union_of)
+                    result[size++] = rhs[j];
+                ++j;
+            } else {
+                if constexpr (op != set_operation::difference_of)
+                    result[size++] = lhs[i];
+                ++i;
+                ++j;
+            }
+        }
+        if constexpr (op != set_operation::intersection_of)
+            while (i < lhs_size)
+                result[size++] = lhs[i++];
+        if constexpr (op == set_operation::union_of)
+            while (j < rhs_size)
+                result[size++] = rhs[j++];
+        return {result, size};
+    }
+
+    template<auto array, std::size_t n>
+    constexpr auto values_from_array() noexcept {
+        return [] <std::size_t... i> (const std::index_sequence<i...>&) {
+            return values<array[i]...>{};
+        }(std::make_index_sequence<n>{});
+    }
+
+    template<typename T>
+    concept printable_value = std::is_arithmetic_v<T> or std::is_enum_v<T>;
+
+    // upper bound for the number of characters written by to_chars for a value (shortest representation)
+    inline constexpr std::size_t max_value_chars = 64;
+
+    // upper bound for the number of characters of the shortest representation of values of type T: the shortest
+    // representation of floating-point numbers is at most as long as the scientific one (sign, digits, point, "e",
+    // exponent sign and up to 5 exponent digits), and integers need at most a sign and digits10 + 1 digits
+    template<typename T>
+    inline constexpr std::size_t max_chars_of = [] () -> std::size_t {
+        if constexpr (std::is_floating_point_v<T>)
+            return 4 + std::numeric_limits<T>::max_digits10 + 5;
+        else if constexpr (std::is_integral_v<T>)
+            return 2 + std::numeric_limits<T>::digits10;
+        else
+            return 2 + std::numeric_limits<unsigned long long>::digits10;
+    } ();
+
+    // writes chars as characters, bools as true/false, enums as their underlying value, and numbers via std::to_chars
+    template<printable_value T>
+    std::to_chars_result to_chars(char* first, char* last, const T& value) noexcept {
+        if constexpr (std::is_enum_v<T>) {
+            using underlying = std::underlying_type_t<T>;
+            using integer = std::conditional_t<std::is_signed_v<underlying>, long long, unsigned long long>;
+            return std::to_chars(first, last, static_cast<integer>(value));
+        } else if constexpr (std::is_same_v<T, bool> or std::is_same_v<T, char>) {
+            const char* text = nullptr;
+            std::ptrdiff_t length = 1;
+            if constexpr (std::is_same_v<T, char>) {
+                text = &value;
+            } else {
+                text = value ? "true" : "false";
+                length = value ? 4 : 5;
+            }
+            if (last - first < length)
+                return {last, std::errc::value_too_large};
+            for (std::ptrdiff_t i = 0; i < length; ++i)
+                *first++ = text[i];
+            return {first, std::errc{}};
+        } else if constexpr (is_any_of_v<T, wchar_t, char8_t, char16_t, char32_t>) {
+            return std::to_chars(first, last, static_cast<std::uint32_t>(value));
+        } else {
+            return std::to_chars(first, last, value);
+        }
+    }
+
+    // intermediate result of a reduction, combined with the next value via operator| to reduce in a fold expression
+    template<typename Op, typename T>
+    struct reduction {
+        Op& action;
+        T value;
+    };
+    template<typename Op, typename T, typename V>
+    constexpr auto operator|(reduction<Op, T>&& r, const V& value) {
+        using result = std::remove_cvref_t<decltype(r.action(std::move(r.value), value))>;
+        return reduction<Op, result>{r.action, r.action(std::move(r.value), value)};
+    }
+
+    template<set_operation op, auto... a, auto... b>
+    constexpr auto apply(const values<a...>&, const values<b...>&) noexcept {
+        using T = first_t<decltype(a)..., decltype(b)..., int>;
+        constexpr auto result = apply<op>(std::array<T, sizeof...(a)>{a...}, std::array<T, sizeof...(b)>{b...});
+        return values_from_array<result.first, result.second>();
+    }
 
 }  // namespace detail
 #endif  // DOXYGEN
 
 //! Class to represent a list of compile-time values.
 template<auto... v>
-struct values : detail::values<std::make_index_sequence<sizeof...(v)>, v...> {
+struct values {
     static constexpr std::size_t size = sizeof...(v);
 
     //! Return a new list with the values from this list, dropping the first n values
     template<std::size_t n> requires(n <= sizeof...(v))
     static constexpr auto drop() noexcept {
-        return [] <auto... _v> (const detail::value_list_helper<_v...>&) constexpr {
-            return values<_v...>{};
-        }(typename detail::drop_n<0, n, v...>::type{});
+        return _slice<n>(std::make_index_sequence<sizeof...(v) - n>{});
     }
 
     //! Return a new list with the values from this list, dropping the last n values
     template<std::size_t n> requires(n <= sizeof...(v))
     static constexpr auto crop() noexcept {
-        return [] <std::size_t... i> (const std::index_sequence<i...>&) constexpr {
-            return values<at(index_constant<i>{})...>{};
-        }(std::make_index_sequence<sizeof...(v) - n>{});
+        return _slice<0>(std::make_index_sequence<sizeof...(v) - n>{});
     }
 
     //! Return a new list with the first n values from this list
     template<std::size_t n> requires(n <= sizeof...(v))
     static constexpr auto take() noexcept {
-        return [] <std::size_t... i> (const std::index_sequence<i...>&) constexpr {
-            return values<at(index_constant<i>{})...>{};
-        }(std::make_index_sequence<n>{});
+        return _slice<0>(std::make_index_sequence<n>{});
     }
 
     //! Return the first value in the list
     static constexpr auto first() noexcept {
-        return at(index_constant<0>{});
+        return at<0>();
     }
 
     //! Return the last value in the list
     static constexpr auto last() noexcept {
-        return at(index_constant<size-1>{});
+        return at<size-1>();
+    }
+
+    //! Return the value at the given index in the list
+    template<std::size_t i> requires(i < size)
+    static constexpr auto at() noexcept {
+#if defined(__cpp_pack_indexing)
+        return v...[i];
+#else
+        if constexpr (detail::have_same_type<v...>)
+            return _values[i];
+        else
+            return detail::value_at<i, v...>;
+#endif
     }
 
     //! Return the value at the given index in the list
     template<std::size_t i> requires(i < size)
-    static constexpr auto at(index_constant<i> idx) noexcept {
-        using base = detail::values<std::make_index_sequence<size>, v...>;
-        return base::at(idx);
+    static constexpr auto at(index_constant<i>) noexcept {
+        return at<i>();
+    }
+
+    //! Return the index of the given (runtime) key in this list, or nullopt if it is not contained (O(1) via a perfect hash)
+    static constexpr std::optional<std::size_t> index_of(const first_t<decltype(v)..., int>& key) noexcept
+    requires(detail::have_same_type<v...> and std::is_integral_v<first_t<decltype(v)..., int>> or
+             detail::have_same_type<v...> and std::is_enum_v<first_t<decltype(v)..., int>>) {
+        if constexpr (size == 0)
+            return std::nullopt;
+        else
+            return detail::perfect_hash_index<v...>::index_of(key);
+    }
+
+    //! Return a reference to a static array containing the values of this list
+    static constexpr const auto& as_array() noexcept requires(detail::have_same_type<v...>) {
+        return _values;
+    }
+
+    //! Return a new list with the values of this list in the order given by Compare (keeps the order of equivalent values)
+    template<typename Compare = detail::less>
+    static constexpr auto sort() noexcept requires(detail::have_same_type<v...>) {
+        constexpr auto result = detail::sort_values<Compare, false>(_values);
+        return detail::values_from_array<result.first, result.second>();
+    }
+
+    //! Return a new list with the values of this list in the order given by Compare, without duplicates
+    template<typename Compare = detail::less>
+    static constexpr auto sort_unique() noexcept requires(detail::have_same_type<v...>) {
+        constexpr auto result = detail::sort_values<Compare, true>(_values);
+        return detail::values_from_array<result.first, result.second>();
     }
 
     //! Perform a reduction operation on this list
     template<typename op, typename T>
     static constexpr auto reduce_with(op&& action, T&& initial) noexcept {
-        return _reduce_with(std::forward<op>(action), std::forward<T>(initial), v...);
+        using reduction = detail::reduction<std::remove_reference_t<op>, std::remove_cvref_t<T>>;
+        return (reduction{action, std::forward<T>(initial)} | ... | v).value;
     }
 
     //! Concatenate this list with another one
@@ -206,34 +869,90 @@ struct values : detail::values<std::make_index_sequence<sizeof...(v)>, v...> {
         return false;
     }
 
-    //! Write this list to the given output stream
-    friend std::ostream& operator<<(std::ostream& s, const values&) {
-        if constexpr (size > 0)
-            _write_to<v...>(s);
-        return s;
+    //! Write the values of this list, separated by ", ", into the given character range (without allocating).
+    //! Returns {last, std::errc::value_too_large} if the range is too small.
+    static std::to_chars_result to_chars(char* first, char* last) noexcept
+    requires(detail::printable_value<decltype(v)> and ...) {
+        std::to_chars_result result{first, std::errc{}};
+        bool is_first = true;
+        [[maybe_unused]] const auto write = [&] (const auto& value) {
+            if (result.ec != std::errc{})
+                return;
+            if (!std::exchange(is_first, false)) {
+                if (last - result.ptr < 2) {
+                    result = {last, std::errc::value_too_large};
+                    return;
+                }
+                *result.ptr++ = ',';
+                *result.ptr++ = ' ';
+            }
+            result = detail::to_chars(result.ptr, last, value);
+        };
+        (..., write(v));
+        return result;
     }
 
- private:
-    template<auto v0, auto... vs>
-    static void _write_to(std::ostream& s) {
-        s << std::to_string(v0);
-        (..., (s << ", " << std::to_string(vs)));
-    }
-
-    template<typename op, typename T>
-    static constexpr auto _reduce_with(op&&, T&& initial) noexcept {
-        return std::forward<T>(initial);
+    //! Write the values of this list, separated by ", ", to the given output iterator (without allocating)
+    template<typename O>
+    static O write_to(O out) requires(requires(O o, char c) { *o++ = c; } and (detail::printable_value<decltype(v)> and ...)) {
+        static_assert(((detail::max_chars_of<decltype(v)> <= detail::max_value_chars) and ...));
+        bool is_first = true;
+        [[maybe_unused]] const auto write = [&] (const auto& value) {
+            if (!std::exchange(is_first, false)) {
+                *out++ = ',';
+                *out++ = ' ';
+            }
+            char buffer[detail::max_value_chars];
+            const auto [end, ec] = detail::to_chars(buffer, buffer + detail::max_value_chars, value);
+            if (ec == std::errc{})
+                for (const char* c = buffer; c != end; ++c)
+                    *out++ = *c;
+        };
+        (..., write(v));
+        return out;
     }
 
-    template<typename op, typename T, typename V0, typename... V>
-    static constexpr auto _reduce_with(op&& action, T&& initial, V0&& v0, V&&... values) noexcept {
-        auto next = action(std::forward<T>(initial), std::forward<V0>(v0));
-        if constexpr (sizeof...(V) == 0) {
-            return next;
-        } else {
-            return _reduce_with(std::forward<op>(action), std::move(next), std::forward<V>(values)...);
-        }
+ private:
+    static constexpr std::array<std::remove_cv_t<first_t<decltype(v)..., int>>, size> _values{v...};
+
+    template<std::size_t offset, std::size_t... i>
+    static constexpr auto _slice(const std::index_sequence<i...>&) noexcept {
+        if constexpr (detail::have_same_type<v...>)
+            return values<_values[offset + i]...>{};
+        else
+            return values<at<offset + i>()...>{};
     }
 };
 
+//! Return the values contained in any of the given lists (sorted and without duplicates)
+template<auto... a, auto... b> requires(detail::have_same_type<a..., b...>)
+constexpr auto set_union(const values<a...>& lhs, const values<b...>& rhs) noexcept {
+    return detail::apply<detail::set_operation::union_of>(lhs, rhs);
+}
+
+//! Return the values contained in both of the given lists (sorted and without duplicates)
+template<auto... a, auto... b> requires(detail::have_same_type<a..., b...>)
+constexpr auto set_intersection(const values<a...>& lhs, const values<b...>& rhs) noexcept {
+    return detail::apply<detail::set_operation::intersection_of>(lhs, rhs);
+}
+
+//! Return the values of the first list that are not contained in the second one (sorted and without duplicates)
+template<auto... a, auto... b> requires(detail::have_same_type<a..., b...>)
+constexpr auto set_difference(const values<a...>& lhs, const values<b...>& rhs) noexcept {
+    return detail::apply<detail::set_operation::difference_of>(lhs, rhs);
+}
+
+//! Invoke the given action with the index_constant and value of all entries of the given list, without a runtime loop
+template<auto... v, typename Action>
+constexpr void unrolled_for(const values<v...>&, Action&& action) {
+    [&] <std::size_t... i> (const std::index_sequence<i...>&) {
+        (..., action(index_constant<i>{}, v));
+    }(std::make_index_sequence<sizeof...(v)>{});
+}
+
 }  // namespace cpputils
+
+// stream output lives in a separate header, such that it can be left out with CPPUTILS_NO_IOSTREAM
+#ifndef CPPUTILS_NO_IOSTREAM
+#include <cpputils/ostream.hpp>
+#endif
@@ -0,0 +1,261 @@
+#pragma once
+
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <concepts>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#include <cpputils/type_traits.hpp>
+#include <cpputils/utility.hpp>
+
+namespace cpputils {
+
+//! Exception thrown when accessing an alternative of a variant that it does not hold
+struct bad_variant_access : std::logic_error {
+    using std::logic_error::logic_error;
+};
+
+//! Type-safe union of a closed set of unique types. In contrast to std::variant, the alternatives are stored in an
+//! untyped buffer (instead of a recursive union), the index is stored in the smallest unsigned integer type that
+//! fits, visitation is a single indirect call through a flat table (see with_index), and values are only converted
+//! into alternatives of the same decayed type. Copy, move and destruction are trivial if they are for all
+//! alternatives. New alternatives are constructed before the current one is destroyed (see emplace); if moving
+//! them into place throws, the variant is left valueless.
+template<typename... Ts> requires(are_unique_v<Ts...> and sizeof...(Ts) > 0 and (std::is_object_v<Ts> and ...))
+class variant {
+    static constexpr std::size_t size = sizeof...(Ts);
+
+    template<std::size_t i>
+    using alternative_t = type_list_at_t<i, type_list<Ts...>>;
+
+    static constexpr bool trivially_destructible = (std::is_trivially_destructible_v<Ts> and ...);
+    static constexpr bool trivially_copyable = trivially_destructible
+        and (std::is_trivially_copy_constructible_v<Ts> and ...)
+        and (std::is_trivially_copy_assignable_v<Ts> and ...);
+    static constexpr bool trivially_movable = trivially_destructible
+        and (std::is_trivially_move_constructible_v<Ts> and ...)
+        and (std::is_trivially_move_assignable_v<Ts> and ...);
+    static constexpr bool copyable = (std::is_copy_constructible_v<Ts> and ...);
+    static constexpr bool movable = (std::is_move_constructible_v<Ts> and ...);
+
+ public:
+    using index_type = detail::smallest_unsigned_t<size>;
+
+    //! Index of a variant that holds no value (after an exception during the construction of an alternative)
+    static constexpr std::size_t npos = size;
+
+    //! Return the index of the given alternative
+    template<typename T>
+    static constexpr auto index_of() noexcept {
+        return indexed<Ts...>{}.template index_of<T>();
+    }
+
+    //! Default-construct the first alternative
+    variant() noexcept(std::is_nothrow_default_constructible_v<first_t<Ts...>>)
+        requires(std::is_default_constructible_v<first_t<Ts...>>) {
+        _construct<first_t<Ts...>>();
+    }
+
+    template<typename T> requires(contains_decayed_v<T, Ts...> and !std::is_same_v<std::remove_cvref_t<T>, variant>)
+    variant(T&& value) noexcept(std::is_nothrow_constructible_v<std::decay_t<T>, T>) {
+        _construct<std::decay_t<T>>(std::forward<T>(value));
+    }
+
+    template<typename T, typename... Args> requires(is_any_of_v<T, Ts...>)
+    explicit variant(std::in_place_type_t<T>, Args&&... args) {
+        _construct<T>(std::forward<Args>(args)...);
+    }
+
+    variant(const variant&) requires(trivially_copyable) = default;
+    variant(const variant& other) requires(copyable and !trivially_copyable) {
+        _construct_from(other);
+    }
+
+    variant(variant&&) requires(trivially_movable) = default;
+    variant(variant&& other) noexcept((std::is_nothrow_move_constructible_v<Ts> and ...))
+        requires(movable and !trivially_movable) {
+        _construct_from(std::move(other));
+    }
+
+    variant& operator=(const variant&) requires(trivially_copyable) = default;
+    variant& operator=(const variant& other) requires(copyable and !trivially_copyable) {
+        if (this != &other) {
+            _destroy();
+            _construct_from(other);
+        }
+        return *this;
+    }
+
+    variant& operator=(variant&&) requires(trivially_movable) = default;
+    variant& operator=(variant&& other) noexcept((std::is_nothrow_move_constructible_v<Ts> and ...))
+        requires(movable and !trivially_movable) {
+        if (this != &other) {
+            _destroy();
+            _construct_from(std::move(other));
+        }
+        return *this;
+    }
+
+    //! Assign to the held alternative if it has the type of the given value (and is assignable from it), and replace
+    //! the alternative otherwise
+    template<typename T> requires(contains_decayed_v<T, Ts...> and !std::is_same_v<std::remove_cvref_t<T>, variant>)
+    variant& operator=(T&& value) {
+        using D = std::decay_t<T>;
+        if constexpr (std::is_assignable_v<D&, T>)
+            if (holds<D>()) {
+                *_get<D>() = std::forward<T>(value);
+                return *this;
+            }
+        emplace<D>(std::forward<T>(value));
+        return *this;
+    }
+
+    ~variant() requires(trivially_destructible) = default;
+    ~variant() requires(!trivially_destructible) {
+        _destroy();
+    }
+
+    //! Destroy the current alternative and construct one of type T from the given arguments. The new value is
+    //! constructed (and moved into place) before the current alternative is destroyed, such that the arguments may
+    //! refer to it. If moving T throws, the variant is left valueless.
+    template<typename T, typename... Args> requires(is_any_of_v<T, Ts...>)
+    T& emplace(Args&&... args) {
+        if constexpr (sizeof...(Args) == 0 or !std::is_move_constructible_v<T>) {
+            _destroy();
+            return _construct<T>(std::forward<Args>(args)...);
+        } else {
+            T value(std::forward<Args>(args)...);
+            _destroy();
+            return _construct<T>(std::move(value));
+        }
+    }
+
+    //! Return the index of the current alternative (or npos if the variant is valueless)
+    constexpr std::size_t index() const noexcept {
+        return _index;
+    }
+
+    constexpr bool valueless_by_exception() const noexcept {
+        return _index == npos;
+    }
+
+    //! Return true if the variant currently holds an alternative of type T
+    template<typename T> requires(is_any_of_v<T, Ts...>)
+    constexpr bool holds() const noexcept {
+        return _index == index_of<T>().value;
+    }
+
+    //! Return a pointer to the alternative of type T, or nullptr if the variant does not hold it
+    template<typename T> requires(is_any_of_v<T, Ts...>)
+    T* get_if() noexcept {
+        return holds<T>() ? _get<T>() : nullptr;
+    }
+
+    //! Return a pointer to the alternative of type T, or nullptr if the variant does not hold it
+    template<typename T> requires(is_any_of_v<T, Ts...>)
+    const T* get_if() const noexcept {
+        return holds<T>() ? _get<T>() : nullptr;
+    }
+
+    //! Return the alternative of type T (throws bad_variant_access if the variant does not hold it)
+    template<typename T> requires(is_any_of_v<T, Ts...>)
+    T& get() & { return *_checked_get<T>(); }
+    template<typename T> requires(is_any_of_v<T, Ts...>)
+    const T& get() const & { return *_checked_get<T>(); }
+    template<typename T> requires(is_any_of_v<T, Ts...>)
+    T&& get() && { return std::move(*_checked_get<T>()); }
+
+    //! Invoke the given action with the current alternative, which must return the same type for all alternatives
+    //! (throws bad_variant_access if the variant is valueless)
+    template<typename Action>
+    decltype(auto) visit(Action&& action) & { return _visit(*this, std::forward<Action>(action)); }
+    template<typename Action>
+    decltype(auto) visit(Action&& action) const & { return _visit(*this, std::forward<Action>(action)); }
+    template<typename Action>
+    decltype(auto) visit(Action&& action) && { return _visit(std::move(*this), std::forward<Action>(action)); }
+
+    friend bool operator==(const variant& lhs, const variant& rhs)
+        requires((std::equality_comparable<Ts> and ...)) {
+        if (lhs._index != rhs._index)
+            return false;
+        if (lhs.valueless_by_exception())
+            return true;
+        return with_index<size>(lhs._index, [&] <std::size_t i> (const index_constant<i>&) -> bool {
+            return *lhs.template _get<alternative_t<i>>() == *rhs.template _get<alternative_t<i>>();
+        });
+    }
+
+ private:
+    template<typename T, typename... Args>
+    T& _construct(Args&&... args) {
+        T* result = ::new (static_cast<void*>(_storage)) T(std::forward<Args>(args)...);
+        _index = static_cast<index_type>(index_of<T>().value);
+        return *result;
+    }
+
+    template<typename Other>
+    void _construct_from(Other&& other) {
+        if (other.valueless_by_exception())
+            _index = npos;
+        else
+            std::forward<Other>(other).visit([&] <typename T> (T&& value) {
+                _construct<std::remove_cvref_t<T>>(std::forward<T>(value));
+            });
+    }
+
+    void _destroy() noexcept {
+        if constexpr (!trivially_destructible)
+            if (!valueless_by_exception())
+                visit([] <typename T> (T& value) { value.~T(); });
+        _index = npos;
+    }
+
+    template<typename T>
+    T* _get() noexcept { return std::launder(reinterpret_cast<T*>(_storage)); }
+    template<typename T>
+    const T* _get() const noexcept { return std::launder(reinterpret_cast<const T*>(_storage)); }
+
+    template<typename T>
+    auto* _checked_get() const {
+        if (!holds<T>())
+            throw bad_variant_access("Variant does not hold the requested alternative");
+        return const_cast<variant*>(this)->template _get<T>();
+    }
+
+    template<typename Self, typename Action>
+    static decltype(auto) _visit(Self&& self, Action&& action) {
+        if (self.valueless_by_exception())
+            throw bad_variant_access("Visiting a valueless variant");
+        return with_index<size>(self._index, [&] <std::size_t i> (const index_constant<i>&) -> decltype(auto) {
+            using T = alternative_t<i>;
+            if constexpr (std::is_const_v<std::remove_reference_t<Self>>)
+                return std::forward<Action>(action)(*self.template _get<T>());
+            else if constexpr (std::is_lvalue_reference_v<Self>)
+                return std::forward<Action>(action)(*self.template _get<T>());
+            else
+                return std::forward<Action>(action)(std::move(*self.template _get<T>()));
+        });
+    }
+
+    alignas(Ts...) std::byte _storage[std::max({sizeof(Ts)...})];
+    index_type _index = npos;
+};
+
+//! Type trait to check if a type is a cpputils::variant
+template<typename T>
+struct is_variant : std::false_type {};
+template<typename... Ts>
+struct is_variant<variant<Ts...>> : std::true_type {};
+template<typename T>
+inline constexpr bool is_variant_v = is_variant<T>::value;
+
+//! Invoke the given action with the current alternative of the given variant
+template<typename Variant, typename Action> requires(is_variant_v<std::remove_cvref_t<Variant>>)
+constexpr decltype(auto) visit(Variant&& variant, Action&& action) {
+    return std::forward<Variant>(variant).visit(std::forward<Action>(action));
+}
+
+}  // namespace cpputils
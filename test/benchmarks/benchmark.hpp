@@ -0,0 +1,40 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <cstddef>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <limits>
+
+namespace cpputils::benchmark {
+
+//! Prevent the compiler from optimizing away the computation of the given value
+template<typename T>
+inline void do_not_optimize(T&& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile auto sink = value;
+    sink = value;
+#endif
+}
+
+//! Run the given action the given number of times (taking the best of a few runs) and print the time per operation
+template<typename Action>
+double measure(const std::string& name, std::size_t operations, Action&& action, std::size_t runs = 5) {
+    using clock = std::chrono::steady_clock;
+    double best = std::numeric_limits<double>::max();
+    for (std::size_t run = 0; run < runs; ++run) {
+        const auto start = clock::now();
+        action();
+        const std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+        best = std::min(best, elapsed.count()/static_cast<double>(operations));
+    }
+    std::cout << std::setw(48) << std::left << name << " "
+              << std::setw(12) << std::right << std::fixed << std::setprecision(3) << best << " ns/op" << std::endl;
+    return best;
+}
+
+}  // namespace cpputils::benchmark
@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+"""Measures the total build time of a synthetic project that uses cpputils in all of its translation units.
+
+The project consists of `--units` translation units, each of which instantiates a few utilities
+(value lists, indexed tuples, type list metafunctions), plus a main file that calls all of them.
+It is built once per mode:
+- `headers`: the units include the cpputils headers
+- `headers_no_iostream`: as above, but with `CPPUTILS_NO_IOSTREAM` defined
+- `pch`: the units include the headers, which are precompiled via the target `cpputils::pch`
+- `module`: the units `import cpputils;` (requires CMake >= 3.28, Ninja and a compiler with module support)
+Each build is a clean, parallel build after configuring the project; the configure step is not measured.
+Results are written as CSV.
+"""
+
+import argparse
+import csv
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+MODES = ["headers", "headers_no_iostream", "pch", "module"]
+
+TARGETS = {
+    "headers": "cpputils::cpputils",
+    "headers_no_iostream": "cpputils::no_iostream",
+    "pch": "cpputils::pch",
+    "module": "cpputils::module"
+}
+
+
+def write_project(path: Path, repository: Path, mode: str, units: int) -> None:
+    if mode == "module":
+        prologue = "import cpputils;\n"
+    else:
+        prologue = "#include <cpputils/type_traits.hpp>\n#include <cpputils/utility.hpp>\n"
+
+    for i in range(units):
+        (path / f"unit_{i}.cpp").write_text(
+            prologue +
+            f"struct tag_{i} {{}};\n"
+            f"int unit_{i}() {{\n"
+            f"    using list = cpputils::values<{i % 7}, {i}, 3, {i % 5}, 1>;\n"
+            f"    static_assert(cpputils::are_unique_v<tag_{i}, int, double, char>);\n"
+            f"    using types = cpputils::unique_t<cpputils::type_list<tag_{i}, int, tag_{i}, char>>;\n"
+            f"    static_assert(types::size == 3);\n"
+            f"    cpputils::indexed_tuple tuple{{{i}, 2.0, 'c'}};\n"
+            f"    int result = static_cast<int>(list::sort_unique().size);\n"
+            f"    cpputils::for_each(tuple, [&] (const auto& value) {{ result += static_cast<int>(value); }});\n"
+            f"    return result;\n"
+            f"}}\n"
+        )
+    declarations = "".join(f"int unit_{i}();\n" for i in range(units))
+    calls = " + ".join(f"unit_{i}()" for i in range(units))
+    (path / "main.cpp").write_text(f"{declarations}int main() {{ return ({calls}) == 0; }}\n")
+
+    sources = " ".join(f"unit_{i}.cpp" for i in range(units))
+    minimum_version = "3.28" if mode == "module" else "3.18"
+    (path / "CMakeLists.txt").write_text(
+        f"cmake_minimum_required(VERSION {minimum_version})\n"
+        "project(cpputils_build_time_benchmark LANGUAGES CXX)\n"
+        f"add_subdirectory({repository.as_posix()} cpputils)\n"
+        f"add_executable(app main.cpp {sources})\n"
+        "target_compile_features(app PRIVATE cxx_std_20)\n"
+        f"target_link_libraries(app PRIVATE {TARGETS[mode]})\n"
+    )
+
+
+def run(command: list, cwd: Path) -> tuple:
+    """Run the given command and return (success, seconds, output)"""
+    start = time.perf_counter()
+    process = subprocess.run(command, cwd=cwd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+    return process.returncode == 0, time.perf_counter() - start, process.stdout
+
+
+def module_support_missing(cmake: str, generator: str) -> str:
+    version = subprocess.run([cmake, "--version"], capture_output=True, text=True).stdout.split()[2]
+    if tuple(int(v) for v in version.split(".")[:2]) < (3, 28):
+        return f"CMake {version} is older than 3.28"
+    if generator is not None and "Ninja" not in generator:
+        return f"the generator '{generator}' does not support modules"
+    if generator is None and shutil.which("ninja") is None:
+        return "ninja was not found"
+    return ""
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--repository", required=True, help="root folder of cpputils (containing CMakeLists.txt)")
+    parser.add_argument("--compiler", default=None, help="C++ compiler used for the project")
+    parser.add_argument("--cmake", default="cmake")
+    parser.add_argument("--generator", default=None, help="CMake generator (default: Ninja if available)")
+    parser.add_argument("--modes", nargs="+", choices=MODES, default=MODES)
+    parser.add_argument("--units", type=int, default=200, help="number of translation units")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count())
+    parser.add_argument("--repetitions", type=int, default=3, help="take the minimum over this many builds")
+    parser.add_argument("--output", default="build_time.csv")
+    args = parser.parse_args()
+
+    generator = args.generator
+    if generator is None and shutil.which("ninja") is not None:
+        generator = "Ninja"
+
+    rows = []
+    for mode in args.modes:
+        print(f"{mode:>20}", flush=True)
+        if mode == "module":
+            reason = module_support_missing(args.cmake, generator)
+            if reason:
+                print(f"    skipped: {reason}", file=sys.stderr)
+                continue
+
+        with tempfile.TemporaryDirectory() as tmp:
+            source, build = Path(tmp) / "source", Path(tmp) / "build"
+            source.mkdir()
+            write_project(source, Path(args.repository).resolve(), mode, args.units)
+            configure = [args.cmake, "-S", str(source), "-B", str(build), "-DCMAKE_BUILD_TYPE=Release"]
+            if generator is not None:
+                configure += ["-G", generator]
+            if args.compiler is not None:
+                configure += [f"-DCMAKE_CXX_COMPILER={args.compiler}"]
+            if mode == "module":
+                configure += ["-DCPPUTILS_BUILD_MODULE=ON"]
+            success, _, output = run(configure, Path(tmp))
+            if not success:
+                print(f"    configuration failed:\n{output}", file=sys.stderr)
+                continue
+
+            times = []
+            for _ in range(args.repetitions):
+                build_command = [args.cmake, "--build", str(build), "--clean-first", "-j", str(args.jobs)]
+                success, seconds, output = run(build_command, Path(tmp))
+                if not success:
+                    first_error = next((l for l in output.splitlines() if "error" in l), output.strip()[-200:])
+                    print(f"    build failed: {first_error}", file=sys.stderr)
+                    break
+                times.append(seconds)
+            if not times:
+                continue
+            print(f"    {min(times):.2f}s", flush=True)
+            rows.append({
+                "mode": mode,
+                "units": args.units,
+                "jobs": args.jobs,
+                "seconds": f"{min(times):.3f}"
+            })
+
+    with open(args.output, "w", newline="") as output:
+        writer = csv.DictWriter(output, fieldnames=["mode", "units", "jobs", "seconds"])
+        writer.writeheader()
+        writer.writerows(rows)
+    print(f"Wrote results to {args.output}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,129 @@
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <variant>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+#include <optional>
+
+#include <cpputils/channels.hpp>
+#include "benchmark.hpp"
+
+using clock_type = std::chrono::steady_clock;
+
+// all messages carry the time at which they were pushed, to measure the latency until they are consumed
+struct price { std::int64_t sent; double value; };
+struct order { std::int64_t sent; std::uint32_t id; std::uint32_t quantity; };
+struct heartbeat { std::int64_t sent; };
+
+std::int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now().time_since_epoch()).count();
+}
+
+// the baseline: a single queue of variants, protected by a mutex
+class mutex_queue {
+ public:
+    using message = std::variant<price, order, heartbeat>;
+
+    void push(message m) {
+        std::lock_guard lock{_mutex};
+        _queue.push_back(std::move(m));
+    }
+
+    template<typename Action>
+    bool poll(Action&& action) {
+        std::optional<message> m;
+        {
+            std::lock_guard lock{_mutex};
+            if (_queue.empty())
+                return false;
+            m.emplace(std::move(_queue.front()));
+            _queue.pop_front();
+        }
+        std::visit(action, std::move(*m));
+        return true;
+    }
+
+ private:
+    std::mutex _mutex;
+    std::deque<message> _queue;
+};
+
+struct latencies {
+    std::vector<std::int64_t> samples;
+
+    void print() {
+        std::sort(samples.begin(), samples.end());
+        double mean = 0.0;
+        for (const auto s : samples)
+            mean += static_cast<double>(s)/static_cast<double>(samples.size());
+        std::cout << std::setw(48) << "" << "   latency mean " << std::setprecision(0) << mean
+                  << " ns, p99 " << samples[samples.size()*99/100] << " ns" << std::endl;
+    }
+};
+
+// one producer pushes the given number of messages (of alternating types), while the consumers poll until all of
+// them have been consumed; the latencies of all messages are appended to the given samples
+template<typename Channel>
+void run(Channel& channel, std::size_t messages, std::size_t consumers, latencies& result) {
+    std::atomic<std::size_t> consumed = 0;
+    std::vector<std::vector<std::int64_t>> samples(consumers);
+    {
+        std::vector<std::jthread> threads;
+        for (std::size_t t = 0; t < consumers; ++t)
+            threads.emplace_back([&, t] () {
+                auto& local = samples[t];
+                local.reserve(messages/consumers + 1);
+                const auto handle = [&] (auto&& message) {
+                    local.push_back(now() - message.sent);
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                };
+                while (consumed.load(std::memory_order_relaxed) < messages)
+                    if (!channel.poll(handle))
+                        std::this_thread::yield();
+            });
+        for (std::size_t i = 0; i < messages; ++i) {
+            switch (i%3) {
+                case 0: channel.push(price{now(), static_cast<double>(i)}); break;
+                case 1: channel.push(order{now(), static_cast<std::uint32_t>(i), 1}); break;
+                default: channel.push(heartbeat{now()}); break;
+            }
+        }
+    }
+    for (const auto& s : samples)
+        result.samples.insert(result.samples.end(), s.begin(), s.end());
+}
+
+int main() {
+    constexpr std::size_t messages = 300000;
+
+    std::cout << "Passing " << messages << " messages of three types from one producer to N consumers "
+              << "(hardware concurrency: " << std::thread::hardware_concurrency() << ")" << std::endl;
+    for (const std::size_t consumers : {1u, 4u, 16u}) {
+        const std::string suffix = " (" + std::to_string(consumers) + " consumers)";
+        {
+            mutex_queue queue;
+            latencies result;
+            cpputils::benchmark::measure("mutex + deque<std::variant>" + suffix, messages, [&] () {
+                run(queue, messages, consumers, result);
+            });
+            result.print();
+        }
+        {
+            cpputils::typed_channels<price, order, heartbeat> channels{1024};
+            latencies result;
+            cpputils::benchmark::measure("typed_channels" + suffix, messages, [&] () {
+                run(channels, messages, consumers, result);
+            });
+            result.print();
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""Measures the compile-time cost of the cases in `compile_time/` for growing input sizes.
+
+Each case is a translation unit that exercises a single metafunction on a list of
+`CPPUTILS_BENCH_SIZE` distinct types (and/or values). For each compiler, case and size,
+the case is compiled in isolation and the wall-clock time and peak memory usage (max RSS)
+of the compiler process are recorded. Results are written as CSV, and optionally the
+compilers' own reports (clang's `-ftime-trace`, gcc's `-ftime-report`) are kept.
+"""
+
+import argparse
+import csv
+import functools
+import os
+import signal
+import subprocess
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+
+def write_prelude(path: Path, size: int) -> None:
+    types = ", ".join(f"bench_t<{i}>" for i in range(size))
+    values = ", ".join(str(i) for i in range(size))
+    path.write_text(
+        "#pragma once\n"
+        "#include <cstddef>\n"
+        "#include <type_traits>\n"
+        "template<std::size_t i> struct bench_t : std::integral_constant<std::size_t, i> {};\n"
+        f"#define CPPUTILS_BENCH_SIZE {size}\n"
+        f"#define CPPUTILS_BENCH_TYPES {types}\n"
+        f"#define CPPUTILS_BENCH_VALUES {values}\n"
+    )
+
+
+@functools.lru_cache
+def compiler_family(compiler: str) -> str:
+    version = subprocess.run([compiler, "--version"], capture_output=True, text=True).stdout
+    return "clang" if "clang" in version else "gcc"
+
+
+def compile_case(compiler: str,
+                 flags: list,
+                 source: Path,
+                 timeout: float,
+                 report_prefix: Path = None) -> tuple:
+    """Compile the given source and return (success, seconds, peak memory in KiB)"""
+    command = [compiler, *flags, "-c", str(source), "-o", os.devnull]
+    if report_prefix is not None:
+        if compiler_family(compiler) == "clang":
+            command += ["-ftime-trace", "-ftime-trace-granularity=0"]
+            command[command.index("-o") + 1] = str(report_prefix.with_suffix(".o"))
+        else:
+            command += ["-ftime-report"]
+
+    # wait4 gives us the resource usage of this particular child process. The compiler output
+    # goes to a file, as it may be large enough to block the process on a full pipe.
+    with tempfile.TemporaryFile(mode="w+") as output:
+        start = time.perf_counter()
+        process = subprocess.Popen(command, stdout=output, stderr=subprocess.STDOUT, start_new_session=True)
+        pid, status, usage = os.wait4(process.pid, os.WNOHANG)
+        while pid == 0:
+            if time.perf_counter() - start > timeout:
+                os.killpg(process.pid, signal.SIGKILL)  # also kill the compiler proper (e.g. cc1plus)
+                print(f"    compilation exceeded the timeout of {timeout}s", file=sys.stderr)
+            time.sleep(0.005)
+            pid, status, usage = os.wait4(process.pid, os.WNOHANG)
+        seconds = time.perf_counter() - start
+        output.seek(0)
+        stderr = output.read()
+    if report_prefix is not None and stderr and compiler_family(compiler) == "gcc":
+        report_prefix.with_suffix(".txt").write_text(stderr)
+    success = os.waitstatus_to_exitcode(status) == 0
+    if not success and seconds <= timeout:
+        first_error = next((l for l in stderr.splitlines() if "error" in l), stderr.strip()[:200])
+        print(f"    compilation failed: {first_error}", file=sys.stderr)
+    return success, seconds, usage.ru_maxrss
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--compiler", action="append", required=True, help="compiler(s) to benchmark")
+    parser.add_argument("--include", required=True, help="include directory containing cpputils/")
+    parser.add_argument("--cases", required=True, help="directory containing the benchmark cases")
+    parser.add_argument("--sizes", nargs="+", type=int, default=[100, 250, 500, 1000])
+    parser.add_argument("--filter", default="", help="only run cases whose name contains this string")
+    parser.add_argument("--repetitions", type=int, default=3, help="take the minimum over this many runs")
+    parser.add_argument("--timeout", type=float, default=120.0, help="abort compilations taking longer (seconds)")
+    parser.add_argument("--output", default="compile_time.csv")
+    parser.add_argument("--reports", default=None, help="keep -ftime-trace/-ftime-report output in this folder")
+    args = parser.parse_args()
+
+    cases = sorted(p for p in Path(args.cases).glob("*.cpp") if args.filter in p.stem)
+    reports = Path(args.reports) if args.reports else None
+    if reports is not None:
+        reports.mkdir(parents=True, exist_ok=True)
+
+    rows = []
+    with tempfile.TemporaryDirectory() as tmp:
+        prelude = Path(tmp) / "prelude.hpp"
+        for size in args.sizes:
+            write_prelude(prelude, size)
+            for compiler in args.compiler:
+                flags = ["-std=c++20", "-O0", f"-I{args.include}", "-include", str(prelude)]
+                for case in cases:
+                    print(f"{Path(compiler).name:>12} {case.stem:>24} {size:>6}", flush=True)
+                    runs = []
+                    for _ in range(args.repetitions):
+                        runs.append(compile_case(compiler, flags, case, args.timeout))
+                        if not runs[-1][0]:
+                            break
+                    success = all(r[0] for r in runs)
+                    if reports is not None and success:
+                        prefix = reports / f"{Path(compiler).name}_{case.stem}_{size}"
+                        compile_case(compiler, flags, case, args.timeout, prefix)
+                    rows.append({
+                        "compiler": Path(compiler).name,
+                        "case": case.stem,
+                        "size": size,
+                        "success": int(success),
+                        "seconds": f"{min(r[1] for r in runs):.4f}",
+                        "max_rss_kib": min(r[2] for r in runs)
+                    })
+
+    with open(args.output, "w", newline="") as output:
+        writer = csv.DictWriter(output, fieldnames=list(rows[0].keys()) if rows else ["case"])
+        writer.writeheader()
+        writer.writerows(rows)
+    print(f"Wrote results to {args.output}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,3 @@
+#include <cpputils/type_traits.hpp>
+
+static_assert(cpputils::are_unique_v<CPPUTILS_BENCH_TYPES>);
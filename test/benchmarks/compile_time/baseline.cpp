@@ -0,0 +1,6 @@
+// Only parses the headers and the generated type list, used as reference for the other cases
+#include <cpputils/type_traits.hpp>
+#include <cpputils/utility.hpp>
+
+using types = cpputils::type_list<CPPUTILS_BENCH_TYPES>;
+static_assert(types::size == CPPUTILS_BENCH_SIZE);
@@ -0,0 +1,8 @@
+#include <type_traits>
+#include <cpputils/type_traits.hpp>
+
+template<typename T>
+struct is_even : std::bool_constant<(T::value%2 == 0)> {};
+
+using filtered = cpputils::filtered_t<is_even, CPPUTILS_BENCH_TYPES>;
+static_assert(filtered::size == (CPPUTILS_BENCH_SIZE + 1)/2);
@@ -0,0 +1,4 @@
+#include <cpputils/utility.hpp>
+
+constexpr cpputils::indexed<CPPUTILS_BENCH_TYPES> indexed;
+static_assert(indexed.template index_of<bench_t<CPPUTILS_BENCH_SIZE - 1>>().value == CPPUTILS_BENCH_SIZE - 1);
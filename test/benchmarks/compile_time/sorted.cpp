@@ -0,0 +1,6 @@
+#include <functional>
+#include <cpputils/type_traits.hpp>
+
+using sorted = cpputils::sorted_t<std::type_identity_t, std::greater<>, CPPUTILS_BENCH_TYPES>;
+static_assert(cpputils::type_list_at_t<0, sorted>::value == CPPUTILS_BENCH_SIZE - 1);
+static_assert(cpputils::type_list_at_t<CPPUTILS_BENCH_SIZE - 1, sorted>::value == 0);
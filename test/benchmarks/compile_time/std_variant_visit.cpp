@@ -0,0 +1,14 @@
+// Reference for the variant_visit case
+#include <variant>
+
+using variant = std::variant<CPPUTILS_BENCH_TYPES>;
+
+std::size_t value_of(const variant& v) {
+    return std::visit([] (const auto& alternative) { return alternative.value; }, v);
+}
+
+variant copy_of(const variant& v) {
+    variant copy = v;
+    copy = bench_t<CPPUTILS_BENCH_SIZE - 1>{};
+    return copy;
+}
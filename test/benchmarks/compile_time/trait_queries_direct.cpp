@@ -0,0 +1,16 @@
+#include <type_traits>
+#include <cpputils/type_traits.hpp>
+
+// queries each type of the list against the whole list (baseline for trait_queries_table)
+using list = cpputils::type_list<CPPUTILS_BENCH_TYPES>;
+
+template<typename T>
+struct is_even : std::bool_constant<(T::value%2 == 0)> {};
+
+template<typename... Ts>
+constexpr std::size_t count_matches(const cpputils::type_list<Ts...>&) {
+    return (std::size_t{0} + ... + (
+        cpputils::is_any_of_v<Ts, list> + cpputils::contains_decayed_v<const Ts&, list> + is_even<Ts>::value
+    ));
+}
+static_assert(count_matches(list{}) == 2*CPPUTILS_BENCH_SIZE + (CPPUTILS_BENCH_SIZE + 1)/2);
@@ -0,0 +1,18 @@
+#include <type_traits>
+#include <cpputils/type_traits.hpp>
+
+// queries each type of the list against a trait_table of the list (see trait_queries_direct)
+using list = cpputils::type_list<CPPUTILS_BENCH_TYPES>;
+
+template<typename T>
+struct is_even : std::bool_constant<(T::value%2 == 0)> {};
+
+using table = cpputils::trait_table<list, is_even>;
+
+template<typename... Ts>
+constexpr std::size_t count_matches(const cpputils::type_list<Ts...>&) {
+    return (std::size_t{0} + ... + (
+        table::contains<Ts>() + table::contains_decayed<const Ts&>() + table::value<is_even, Ts>()
+    ));
+}
+static_assert(count_matches(list{}) == 2*CPPUTILS_BENCH_SIZE + (CPPUTILS_BENCH_SIZE + 1)/2);
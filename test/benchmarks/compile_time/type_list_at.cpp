@@ -0,0 +1,9 @@
+#include <utility>
+#include <cpputils/type_traits.hpp>
+
+using types = cpputils::type_list<CPPUTILS_BENCH_TYPES>;
+
+// access all elements
+static_assert([] <std::size_t... i> (const std::index_sequence<i...>&) {
+    return (std::is_same_v<cpputils::type_list_at_t<i, types>, bench_t<i>> && ...);
+}(std::make_index_sequence<CPPUTILS_BENCH_SIZE>{}));
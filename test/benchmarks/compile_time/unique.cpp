@@ -0,0 +1,5 @@
+#include <cpputils/type_traits.hpp>
+
+using types = cpputils::type_list<CPPUTILS_BENCH_TYPES, CPPUTILS_BENCH_TYPES>;
+using unique = cpputils::unique_t<types>;
+static_assert(unique::size == CPPUTILS_BENCH_SIZE);
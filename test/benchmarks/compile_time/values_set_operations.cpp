@@ -0,0 +1,8 @@
+#include <cpputils/utility.hpp>
+
+using values = cpputils::values<CPPUTILS_BENCH_VALUES>;
+constexpr auto lower = values::take<CPPUTILS_BENCH_SIZE/2 + 1>();
+constexpr auto upper = values::drop<CPPUTILS_BENCH_SIZE/2>();
+static_assert(cpputils::set_union(lower, upper).size == CPPUTILS_BENCH_SIZE);
+static_assert(cpputils::set_intersection(lower, upper).size == 1);
+static_assert(cpputils::set_difference(lower, upper).size == CPPUTILS_BENCH_SIZE/2);
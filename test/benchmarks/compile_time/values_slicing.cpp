@@ -0,0 +1,6 @@
+#include <cpputils/utility.hpp>
+
+using values = cpputils::values<CPPUTILS_BENCH_VALUES>;
+static_assert(values::take<CPPUTILS_BENCH_SIZE/2>().size == CPPUTILS_BENCH_SIZE/2);
+static_assert(values::crop<CPPUTILS_BENCH_SIZE/2>().size == CPPUTILS_BENCH_SIZE - CPPUTILS_BENCH_SIZE/2);
+static_assert(values::drop<CPPUTILS_BENCH_SIZE/2>().last() == CPPUTILS_BENCH_SIZE - 1);
@@ -0,0 +1,6 @@
+#include <functional>
+#include <cpputils/utility.hpp>
+
+using values = cpputils::values<CPPUTILS_BENCH_VALUES>;
+static_assert(values::sort<std::greater<>>().first() == CPPUTILS_BENCH_SIZE - 1);
+static_assert((values{} + values{}).sort_unique().size == CPPUTILS_BENCH_SIZE);
@@ -0,0 +1,13 @@
+#include <cpputils/variant.hpp>
+
+using variant = cpputils::variant<CPPUTILS_BENCH_TYPES>;
+
+std::size_t value_of(const variant& v) {
+    return v.visit([] (const auto& alternative) { return alternative.value; });
+}
+
+variant copy_of(const variant& v) {
+    variant copy = v;
+    copy = bench_t<CPPUTILS_BENCH_SIZE - 1>{};
+    return copy;
+}
@@ -0,0 +1,78 @@
+#include <vector>
+#include <thread>
+#include <cstddef>
+#include <cstdlib>
+#include <numeric>
+#include <iostream>
+
+#include <cpputils/expressions.hpp>
+#include <cpputils/parallel.hpp>
+#include "benchmark.hpp"
+
+// the baseline: operators on vectors that return a new vector per operation
+namespace eager {
+
+template<typename Op>
+std::vector<double> apply(const std::vector<double>& a, const std::vector<double>& b, Op op) {
+    std::vector<double> result(a.size());
+    for (std::size_t i = 0; i < a.size(); ++i)
+        result[i] = op(a[i], b[i]);
+    return result;
+}
+
+std::vector<double> operator+(const std::vector<double>& a, const std::vector<double>& b) {
+    return apply(a, b, [] (double x, double y) { return x + y; });
+}
+
+std::vector<double> operator*(const std::vector<double>& a, const std::vector<double>& b) {
+    return apply(a, b, [] (double x, double y) { return x*y; });
+}
+
+}  // namespace eager
+
+int main() {
+    using eager::operator+;
+    using eager::operator*;
+
+    cpputils::thread_pool pool;
+    std::cout << "Evaluating a*b + c*d + a (worker threads: " << pool.size() << ")" << std::endl;
+    for (const std::size_t size : {std::size_t{1} << 10, std::size_t{1} << 16, std::size_t{1} << 22}) {
+        std::vector<double> a(size), b(size), c(size), d(size), out(size);
+        std::iota(a.begin(), a.end(), 0.0);
+        std::iota(b.begin(), b.end(), 1.0);
+        std::iota(c.begin(), c.end(), 2.0);
+        std::iota(d.begin(), d.end(), 3.0);
+        const std::size_t runs = std::max<std::size_t>(1, (std::size_t{1} << 24)/size);
+        const std::size_t operations = runs*size;
+        const std::string suffix = " (" + std::to_string(size) + " elements)";
+
+        cpputils::benchmark::measure("temporary vectors" + suffix, operations, [&] () {
+            for (std::size_t r = 0; r < runs; ++r) {
+                out = a*b + c*d + a;
+                cpputils::benchmark::do_not_optimize(out.data());
+            }
+        });
+        cpputils::benchmark::measure("hand-written loop" + suffix, operations, [&] () {
+            for (std::size_t r = 0; r < runs; ++r) {
+                for (std::size_t i = 0; i < size; ++i)
+                    out[i] = a[i]*b[i] + c[i]*d[i] + a[i];
+                cpputils::benchmark::do_not_optimize(out.data());
+            }
+        });
+        const auto e = cpputils::lazy(a)*b + cpputils::lazy(c)*d + a;
+        cpputils::benchmark::measure("expression" + suffix, operations, [&] () {
+            for (std::size_t r = 0; r < runs; ++r) {
+                cpputils::evaluate(e, out);
+                cpputils::benchmark::do_not_optimize(out.data());
+            }
+        });
+        cpputils::benchmark::measure("expression with thread_pool" + suffix, operations, [&] () {
+            for (std::size_t r = 0; r < runs; ++r) {
+                cpputils::evaluate(e, out, pool);
+                cpputils::benchmark::do_not_optimize(out.data());
+            }
+        });
+    }
+
+    return EXIT_SUCCESS;
+}
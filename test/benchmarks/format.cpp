@@ -0,0 +1,39 @@
+#include <string>
+#include <sstream>
+#include <cstdlib>
+#include <iostream>
+
+#include <cpputils/utility.hpp>
+#include "benchmark.hpp"
+
+int main() {
+    using table = decltype([] <std::size_t... i> (const std::index_sequence<i...>&) {
+        return cpputils::values<static_cast<int>(i*7919 % 100003)...>{};
+    }(std::make_index_sequence<256>{}));
+    constexpr std::size_t repetitions = 2000;
+
+    std::cout << "Printing a list of " << table::size << " values" << std::endl;
+    std::ostringstream stream;
+    cpputils::benchmark::measure("ostream << std::to_string per value", table::size*repetitions, [&] () {
+        for (std::size_t r = 0; r < repetitions; ++r) {
+            stream.str({});
+            for (std::size_t i = 0; i < table::size; ++i)
+                stream << (i > 0 ? ", " : "") << std::to_string(table::as_array()[i]);
+        }
+        cpputils::benchmark::do_not_optimize(stream);
+    });
+    cpputils::benchmark::measure("ostream << values", table::size*repetitions, [&] () {
+        for (std::size_t r = 0; r < repetitions; ++r) {
+            stream.str({});
+            stream << table{};
+        }
+        cpputils::benchmark::do_not_optimize(stream);
+    });
+    cpputils::benchmark::measure("values::to_chars into a stack buffer", table::size*repetitions, [&] () {
+        char buffer[table::size*16];
+        for (std::size_t r = 0; r < repetitions; ++r)
+            cpputils::benchmark::do_not_optimize(table::to_chars(buffer, buffer + sizeof(buffer)).ptr);
+    });
+
+    return EXIT_SUCCESS;
+}
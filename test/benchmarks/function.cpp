@@ -0,0 +1,67 @@
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+#include <functional>
+
+#include <cpputils/utility.hpp>
+#include "benchmark.hpp"
+
+int main() {
+    constexpr std::size_t callbacks = 1000;
+    constexpr std::size_t repetitions = 1000;
+    double a = 1.0, b = 2.0, c = 3.0;
+
+    // captures 24 bytes, which exceeds the small-buffer of std::function in the common standard libraries
+    const auto make_callback = [&] (std::size_t i) {
+        return [pa = &a, pb = &b, scale = static_cast<double>(i)] (double x) { return *pa*x + *pb*scale; };
+    };
+    using callback_t = decltype(make_callback(0));
+    std::cout << "Callbacks with a capture of " << sizeof(callback_t) << " bytes" << std::endl;
+
+    cpputils::benchmark::measure("construct std::function", callbacks*repetitions, [&] () {
+        for (std::size_t r = 0; r < repetitions; ++r)
+            for (std::size_t i = 0; i < callbacks; ++i) {
+                std::function<double(double)> f{make_callback(i)};
+                cpputils::benchmark::do_not_optimize(f);
+            }
+    });
+    cpputils::benchmark::measure("construct inplace_function", callbacks*repetitions, [&] () {
+        for (std::size_t r = 0; r < repetitions; ++r)
+            for (std::size_t i = 0; i < callbacks; ++i) {
+                cpputils::inplace_function<double(double)> f{make_callback(i)};
+                cpputils::benchmark::do_not_optimize(f);
+            }
+    });
+    cpputils::benchmark::measure("construct function_ref", callbacks*repetitions, [&] () {
+        for (std::size_t r = 0; r < repetitions; ++r)
+            for (std::size_t i = 0; i < callbacks; ++i) {
+                const auto callback = make_callback(i);
+                cpputils::function_ref<double(double)> f{callback};
+                cpputils::benchmark::do_not_optimize(f);
+            }
+    });
+
+    std::vector<std::function<double(double)>> std_functions;
+    std::vector<cpputils::inplace_function<double(double)>> inplace_functions;
+    std::vector<callback_t> plain_callbacks;
+    for (std::size_t i = 0; i < callbacks; ++i) {
+        std_functions.emplace_back(make_callback(i));
+        inplace_functions.emplace_back(make_callback(i));
+        plain_callbacks.push_back(make_callback(i));
+    }
+    std::vector<cpputils::function_ref<double(double)>> function_refs{plain_callbacks.begin(), plain_callbacks.end()};
+
+    const auto call_all = [&] (const auto& functions) {
+        for (std::size_t r = 0; r < repetitions; ++r) {
+            double sum = 0.0;
+            for (const auto& f : functions)
+                sum += f(c);
+            cpputils::benchmark::do_not_optimize(sum);
+        }
+    };
+    cpputils::benchmark::measure("call std::function", callbacks*repetitions, [&] () { call_all(std_functions); });
+    cpputils::benchmark::measure("call inplace_function", callbacks*repetitions, [&] () { call_all(inplace_functions); });
+    cpputils::benchmark::measure("call function_ref", callbacks*repetitions, [&] () { call_all(function_refs); });
+
+    return EXIT_SUCCESS;
+}
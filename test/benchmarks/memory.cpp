@@ -0,0 +1,123 @@
+#include <thread>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+#include <memory_resource>
+
+#include <cpputils/memory.hpp>
+#include "benchmark.hpp"
+
+struct particle { double position[3]; double velocity[3]; };
+struct event { int type; float time; };
+struct node { node* children[4]; };
+
+// allocates objects of all types in an interleaved order and frees them in a different (interleaved) order
+template<typename Allocate, typename Deallocate>
+void churn(std::size_t count, std::size_t rounds, Allocate&& allocate, Deallocate&& deallocate) {
+    std::vector<particle*> particles(count);
+    std::vector<event*> events(count);
+    std::vector<node*> nodes(count);
+    for (std::size_t round = 0; round < rounds; ++round) {
+        for (std::size_t i = 0; i < count; ++i) {
+            particles[i] = allocate(particles[i]);
+            events[i] = allocate(events[i]);
+            nodes[i] = allocate(nodes[i]);
+        }
+        cpputils::benchmark::do_not_optimize(particles.data());
+        for (std::size_t i = 0; i < count; i += 2)
+            deallocate(particles[i]), deallocate(events[i]), deallocate(nodes[i]);
+        for (std::size_t i = 1; i < count; i += 2)
+            deallocate(nodes[i]), deallocate(events[i]), deallocate(particles[i]);
+    }
+}
+
+int main() {
+    constexpr std::size_t count = 10000;
+    constexpr std::size_t rounds = 20;
+    constexpr std::size_t operations = 3*count*rounds;
+    const std::size_t threads = std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+
+    const auto new_delete = [] (auto* p) {
+        using T = std::remove_pointer_t<decltype(p)>;
+        return static_cast<T*>(::operator new(sizeof(T)));
+    };
+    const auto delete_object = [] (auto* p) { ::operator delete(p); };
+    const auto with_resource = [] (std::pmr::memory_resource& resource) {
+        return std::pair{
+            [&resource] (auto* p) {
+                using T = std::remove_pointer_t<decltype(p)>;
+                return static_cast<T*>(resource.allocate(sizeof(T), alignof(T)));
+            },
+            [&resource] (auto* p) {
+                using T = std::remove_pointer_t<decltype(p)>;
+                resource.deallocate(p, sizeof(T), alignof(T));
+            }
+        };
+    };
+    const auto with_pools = [] (auto& pools) {
+        return std::pair{
+            [&pools] (auto* p) { return pools.template allocate<std::remove_pointer_t<decltype(p)>>(); },
+            [&pools] (auto* p) { pools.deallocate(p); }
+        };
+    };
+
+    std::cout << "Allocating and freeing " << count << " objects of three types, single-threaded" << std::endl;
+    cpputils::benchmark::measure("new/delete", operations, [&] () {
+        churn(count, rounds, new_delete, delete_object);
+    });
+    {
+        std::pmr::unsynchronized_pool_resource resource;
+        const auto [allocate, deallocate] = with_resource(resource);
+        cpputils::benchmark::measure("pmr::unsynchronized_pool_resource", operations, [&] () {
+            churn(count, rounds, allocate, deallocate);
+        });
+    }
+    {
+        cpputils::typed_pools<particle, event, node> pools;
+        const auto [allocate, deallocate] = with_pools(pools);
+        cpputils::benchmark::measure("typed_pools", operations, [&] () {
+            churn(count, rounds, allocate, deallocate);
+        });
+    }
+    {
+        cpputils::typed_pools<particle, event, node> pools;
+        const auto [allocate, deallocate] = with_resource(pools);
+        cpputils::benchmark::measure("typed_pools as memory_resource", operations, [&] () {
+            churn(count, rounds, allocate, deallocate);
+        });
+    }
+    {
+        cpputils::arena arena;
+        const auto [allocate, deallocate] = with_resource(arena);
+        cpputils::benchmark::measure("arena (released after each run)", operations, [&] () {
+            churn(count, rounds, allocate, deallocate);
+            arena.release();
+        });
+    }
+
+    std::cout << "Allocating and freeing " << count << " objects of three types, on " << threads << " threads" << std::endl;
+    const auto concurrently = [&] (auto&& action) {
+        std::vector<std::jthread> workers;
+        for (std::size_t t = 0; t < threads; ++t)
+            workers.emplace_back(action);
+    };
+    cpputils::benchmark::measure("new/delete", operations*threads, [&] () {
+        concurrently([&] () { churn(count, rounds, new_delete, delete_object); });
+    });
+    {
+        std::pmr::synchronized_pool_resource resource;
+        const auto [allocate, deallocate] = with_resource(resource);
+        cpputils::benchmark::measure("pmr::synchronized_pool_resource", operations*threads, [&] () {
+            concurrently([&] () { churn(count, rounds, allocate, deallocate); });
+        });
+    }
+    {
+        cpputils::typed_pools<particle, event, node> pools;
+        const auto [allocate, deallocate] = with_pools(pools);
+        cpputils::benchmark::measure("typed_pools", operations*threads, [&] () {
+            concurrently([&] () { churn(count, rounds, allocate, deallocate); });
+        });
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,122 @@
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+#include <unordered_map>
+
+#include <cpputils/metrics.hpp>
+#include "benchmark.hpp"
+
+struct parse {};
+struct route {};
+struct store {};
+
+// the baseline: statistics in a map keyed by the event name, protected by a mutex
+class named_metrics {
+ public:
+    void record(const std::string& name, std::chrono::nanoseconds duration) {
+        const auto ns = static_cast<std::uint64_t>(duration.count());
+        std::lock_guard lock{_mutex};
+        auto& statistics = _statistics[name];
+        statistics.min_ns = statistics.count == 0 ? ns : std::min(statistics.min_ns, ns);
+        statistics.max_ns = std::max(statistics.max_ns, ns);
+        statistics.count++;
+        statistics.total_ns += ns;
+        statistics.histogram[cpputils::type_statistics::bucket_of(ns)]++;
+    }
+
+ private:
+    std::mutex _mutex;
+    std::unordered_map<std::string, cpputils::type_statistics> _statistics;
+};
+
+// a processing loop that records one event per iteration, alternating between the three types
+template<typename Record>
+void process(std::size_t events, Record&& record) {
+    std::uint64_t state = 1;
+    for (std::size_t i = 0; i < events; ++i) {
+        state = state*6364136223846793005ull + 1442695040888963407ull;
+        const auto duration = std::chrono::nanoseconds{state >> 54};
+        switch (i%3) {
+            case 0: record(parse{}, "parse", duration); break;
+            case 1: record(route{}, "route", duration); break;
+            default: record(store{}, "store", duration); break;
+        }
+    }
+    cpputils::benchmark::do_not_optimize(state);
+}
+
+int main() {
+    constexpr std::size_t events = 3000000;
+    const std::size_t threads = std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+
+    const auto none = [] (auto, const char*, std::chrono::nanoseconds duration) {
+        cpputils::benchmark::do_not_optimize(duration);
+    };
+    const auto by_name = [] (named_metrics& metrics) {
+        return [&metrics] (auto, const std::string& name, std::chrono::nanoseconds duration) {
+            metrics.record(name, duration);
+        };
+    };
+    const auto by_type = [] (auto& metrics) {
+        return [&metrics] <typename T> (T, const char*, std::chrono::nanoseconds duration) {
+            metrics.template record<T>(duration);
+        };
+    };
+    const auto timed = [] (auto& metrics) {
+        return [&metrics] <typename T> (T, const char*, std::chrono::nanoseconds duration) {
+            const auto timer = metrics.template measure<T>();
+            cpputils::benchmark::do_not_optimize(duration);
+        };
+    };
+
+    for (const std::size_t t : {std::size_t{1}, threads}) {
+        std::cout << "Recording " << events << " events of three types on " << t << " thread(s)" << std::endl;
+        const auto concurrently = [&] (auto&& action) {
+            std::vector<std::jthread> workers;
+            for (std::size_t i = 0; i < t; ++i)
+                workers.emplace_back(action);
+        };
+        cpputils::benchmark::measure("no instrumentation", events*t, [&] () {
+            concurrently([&] () { process(events, none); });
+        });
+        {
+            named_metrics metrics;
+            cpputils::benchmark::measure("mutex + unordered_map<string, statistics>", events*t, [&] () {
+                concurrently([&] () { process(events, by_name(metrics)); });
+            });
+        }
+        {
+            cpputils::type_metrics<parse, route, store> metrics;
+            cpputils::benchmark::measure("type_metrics::record", events*t, [&] () {
+                concurrently([&] () { process(events, by_type(metrics)); });
+            });
+        }
+        {
+            // e.g. one instance per pipeline stage, recorded into alternately by the same threads
+            cpputils::type_metrics<parse, route, store> first, second;
+            const auto alternating = [&] () {
+                return [&, i = std::size_t{0}] <typename T> (T, const char*, std::chrono::nanoseconds duration) mutable {
+                    auto& metrics = i++%2 == 0 ? first : second;
+                    metrics.template record<T>(duration);
+                };
+            };
+            cpputils::benchmark::measure("type_metrics::record (two instances)", events*t, [&] () {
+                concurrently([&] () { process(events, alternating()); });
+            });
+        }
+        {
+            cpputils::type_metrics<parse, route, store> metrics;
+            cpputils::benchmark::measure("type_metrics::measure (including the clock)", events*t, [&] () {
+                concurrently([&] () { process(events, timed(metrics)); });
+            });
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,90 @@
+#include <random>
+#include <vector>
+#include <numeric>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+
+#include <cpputils/utility.hpp>
+#include <cpputils/numeric.hpp>
+#include "benchmark.hpp"
+
+// offsets and coefficients of a 9-point stencil, as compile-time value lists
+using offsets = cpputils::values<-4, -3, -2, -1, 0, 1, 2, 3, 4>;
+using stencil = cpputils::values<1.0, -8.0, 28.0, -56.0, 70.0, -56.0, 28.0, -8.0, 1.0>;
+
+int main() {
+    constexpr std::size_t size = 1 << 16;
+    constexpr std::size_t repetitions = 200;
+    std::mt19937 generator{42};
+    std::uniform_real_distribution<double> distribution{-1.0, 1.0};
+    std::vector<double> x(size), y(size);
+    std::ranges::generate(x, [&] () { return distribution(generator); });
+    std::ranges::generate(y, [&] () { return distribution(generator); });
+
+    std::cout << "Reductions over " << size << " doubles" << std::endl;
+    cpputils::benchmark::measure("std::accumulate", size*repetitions, [&] () {
+        for (std::size_t r = 0; r < repetitions; ++r)
+            cpputils::benchmark::do_not_optimize(std::accumulate(x.begin(), x.end(), 0.0));
+    });
+    cpputils::benchmark::measure("cpputils::sum", size*repetitions, [&] () {
+        for (std::size_t r = 0; r < repetitions; ++r)
+            cpputils::benchmark::do_not_optimize(cpputils::sum(x));
+    });
+    cpputils::benchmark::measure("std::ranges::max", size*repetitions, [&] () {
+        for (std::size_t r = 0; r < repetitions; ++r)
+            cpputils::benchmark::do_not_optimize(std::ranges::max(x));
+    });
+    cpputils::benchmark::measure("cpputils::max", size*repetitions, [&] () {
+        for (std::size_t r = 0; r < repetitions; ++r)
+            cpputils::benchmark::do_not_optimize(cpputils::max(x));
+    });
+    cpputils::benchmark::measure("std::inner_product", size*repetitions, [&] () {
+        for (std::size_t r = 0; r < repetitions; ++r)
+            cpputils::benchmark::do_not_optimize(std::inner_product(x.begin(), x.end(), y.begin(), 0.0));
+    });
+    cpputils::benchmark::measure("cpputils::dot", size*repetitions, [&] () {
+        for (std::size_t r = 0; r < repetitions; ++r)
+            cpputils::benchmark::do_not_optimize(cpputils::dot(x, y));
+    });
+
+    std::cout << "Applying a " << stencil::size << "-point stencil to " << size << " doubles" << std::endl;
+    const std::size_t points = size - stencil::size + 1;
+    cpputils::benchmark::measure("values::reduce_with", points*repetitions, [&] () {
+        for (std::size_t r = 0; r < repetitions; ++r) {
+            for (std::size_t i = 0; i < points; ++i) {
+                std::size_t k = 0;
+                y[i] = stencil::reduce_with([&] (double sum, double w) { return sum + w*x[i + k++]; }, 0.0);
+            }
+            cpputils::benchmark::do_not_optimize(y.data());
+        }
+    });
+    cpputils::benchmark::measure("cpputils::dot with values::as_array", points*repetitions, [&] () {
+        for (std::size_t r = 0; r < repetitions; ++r) {
+            for (std::size_t i = 0; i < points; ++i)
+                y[i] = cpputils::dot(stencil::as_array(), std::span<const double, stencil::size>{x.data() + i, stencil::size});
+            cpputils::benchmark::do_not_optimize(y.data());
+        }
+    });
+    cpputils::benchmark::measure("runtime loop over std::array", points*repetitions, [&] () {
+        constexpr std::array<int, stencil::size> runtime_offsets{-4, -3, -2, -1, 0, 1, 2, 3, 4};
+        constexpr auto weights = stencil::as_array();
+        for (std::size_t r = 0; r < repetitions; ++r) {
+            for (std::size_t i = 4; i < size - 4; ++i) {
+                double value = 0.0;
+                for (std::size_t k = 0; k < weights.size(); ++k)
+                    value += weights[k]*x[i + runtime_offsets[k]];
+                y[i] = value;
+            }
+            cpputils::benchmark::do_not_optimize(y.data());
+        }
+    });
+    cpputils::benchmark::measure("cpputils::stencil_apply", points*repetitions, [&] () {
+        for (std::size_t r = 0; r < repetitions; ++r) {
+            cpputils::stencil_apply(offsets{}, stencil{}, x, y);
+            cpputils::benchmark::do_not_optimize(y.data());
+        }
+    });
+
+    return EXIT_SUCCESS;
+}
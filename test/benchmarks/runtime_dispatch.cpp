@@ -0,0 +1,62 @@
+#include <random>
+#include <vector>
+#include <variant>
+#include <cstdint>
+#include <cstdlib>
+
+#include <cpputils/utility.hpp>
+#include "benchmark.hpp"
+
+template<std::size_t i>
+struct element {
+    std::uint64_t value;
+    std::uint64_t operator()(std::uint64_t x) const { return x*(i + 1) + value; }
+};
+
+template<std::size_t n>
+void run() {
+    auto tuple = [] <std::size_t... i> (const std::index_sequence<i...>&) {
+        return cpputils::indexed_tuple{element<i>{i}...};
+    }(std::make_index_sequence<n>{});
+    using variant = decltype([] <std::size_t... i> (const std::index_sequence<i...>&) {
+        return std::variant<element<i>...>{};
+    }(std::make_index_sequence<n>{}));
+
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<std::size_t> distribution{0, n - 1};
+    std::vector<std::size_t> indices(1 << 20);
+    std::vector<variant> variants(indices.size());
+    for (std::size_t k = 0; k < indices.size(); ++k) {
+        indices[k] = distribution(generator);
+        cpputils::with_index<n>(indices[k], [&] (auto i) { variants[k] = element<i.value>{i.value}; });
+    }
+
+    std::cout << "Dispatching on " << indices.size() << " random indices into " << n << " alternatives" << std::endl;
+    cpputils::benchmark::measure("cpputils::visit (jump table)", indices.size(), [&] () {
+        std::uint64_t sum = 0;
+        for (auto i : indices)
+            sum += cpputils::visit(tuple, i, [&] (const auto& e) { return e(sum); });
+        cpputils::benchmark::do_not_optimize(sum);
+    });
+    cpputils::benchmark::measure("if-chain", indices.size(), [&] () {
+        std::uint64_t sum = 0;
+        for (auto i : indices)
+            [&] <std::size_t... j> (const std::index_sequence<j...>&) {
+                (... || (i == j && (sum += tuple.get(cpputils::ic<j>)(sum), true)));
+            }(std::make_index_sequence<n>{});
+        cpputils::benchmark::do_not_optimize(sum);
+    });
+    cpputils::benchmark::measure("std::visit on std::variant", indices.size(), [&] () {
+        std::uint64_t sum = 0;
+        for (const auto& v : variants)
+            sum += std::visit([&] (const auto& e) { return e(sum); }, v);
+        cpputils::benchmark::do_not_optimize(sum);
+    });
+}
+
+int main() {
+    run<4>();
+    run<16>();
+    run<64>();
+    return EXIT_SUCCESS;
+}
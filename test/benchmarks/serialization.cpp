@@ -0,0 +1,51 @@
+#include <vector>
+#include <string>
+#include <sstream>
+#include <cstdlib>
+#include <iostream>
+
+#include <cpputils/serialization.hpp>
+#include "benchmark.hpp"
+
+using record = cpputils::indexed_tuple<std::int64_t, double, float, std::uint32_t>;
+
+int main() {
+    constexpr std::size_t count = 1 << 16;
+    const record written{42, 3.14, 2.5f, 7u};
+    const std::size_t record_size = cpputils::serialized_size(written);
+    std::vector<std::byte> buffer(count*record_size);
+
+    std::cout << "Serializing " << count << " records of " << record::size << " elements" << std::endl;
+    cpputils::benchmark::measure("cpputils::serialize (memcpy)", count, [&] () {
+        std::size_t offset = 0;
+        for (std::size_t i = 0; i < count; ++i)
+            offset += cpputils::serialize(written, std::span{buffer}.subspan(offset));
+        cpputils::benchmark::do_not_optimize(buffer.data());
+    });
+    cpputils::benchmark::measure("cpputils::deserialize (memcpy)", count, [&] () {
+        record read{0, 0.0, 0.0f, 0u};
+        std::span<const std::byte> input{buffer};
+        for (std::size_t i = 0; i < count; ++i) {
+            input = input.subspan(cpputils::deserialize(read, input));
+            cpputils::benchmark::do_not_optimize(read);
+        }
+    });
+
+    std::stringstream stream;
+    cpputils::benchmark::measure("std::ostream::write per element", count, [&] () {
+        stream.str({});
+        for (std::size_t i = 0; i < count; ++i)
+            cpputils::for_each(written, [&] (const auto& e) { stream.write(reinterpret_cast<const char*>(&e), sizeof(e)); });
+        cpputils::benchmark::do_not_optimize(stream);
+    });
+    cpputils::benchmark::measure("std::istream::read per element", count, [&] () {
+        record read{0, 0.0, 0.0f, 0u};
+        stream.seekg(0);
+        for (std::size_t i = 0; i < count; ++i) {
+            cpputils::for_each(read, [&] (auto& e) { stream.read(reinterpret_cast<char*>(&e), sizeof(e)); });
+            cpputils::benchmark::do_not_optimize(read);
+        }
+    });
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,66 @@
+#include <memory>
+#include <random>
+#include <vector>
+#include <variant>
+#include <cstdlib>
+
+#include <cpputils/type_collection.hpp>
+#include "benchmark.hpp"
+
+struct event_base {
+    virtual ~event_base() = default;
+    virtual double process(double x) const = 0;
+};
+
+template<int i>
+struct virtual_event : event_base {
+    explicit virtual_event(double v) : value{v} {}
+    double process(double x) const override { return x*(i + 1) + value; }
+    double value;
+};
+
+template<int i>
+struct event {
+    double process(double x) const { return x*(i + 1) + value; }
+    double value;
+};
+
+int main() {
+    constexpr std::size_t count = 1 << 22;
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int> distribution{0, 3};
+
+    std::vector<std::unique_ptr<event_base>> pointers;
+    std::vector<std::variant<event<0>, event<1>, event<2>, event<3>>> variants;
+    cpputils::type_collection<event<0>, event<1>, event<2>, event<3>> collection;
+    pointers.reserve(count);
+    variants.reserve(count);
+    for (std::size_t k = 0; k < count; ++k) {
+        const double value = static_cast<double>(k%7);
+        cpputils::with_index<4>(distribution(generator), [&] (auto i) {
+            pointers.push_back(std::make_unique<virtual_event<i.value>>(value));
+            variants.push_back(event<i.value>{value});
+            collection.insert(event<i.value>{value});
+        });
+    }
+
+    std::cout << "Processing " << count << " events of 4 types" << std::endl;
+    cpputils::benchmark::measure("type_collection::for_each", count, [&] () {
+        double sum = 0.0;
+        collection.for_each([&] (const auto& e) { sum = e.process(sum)*0.5; });
+        cpputils::benchmark::do_not_optimize(sum);
+    });
+    cpputils::benchmark::measure("std::vector<std::unique_ptr<base>>", count, [&] () {
+        double sum = 0.0;
+        for (const auto& e : pointers)
+            sum = e->process(sum)*0.5;
+        cpputils::benchmark::do_not_optimize(sum);
+    });
+    cpputils::benchmark::measure("std::vector<std::variant<...>>", count, [&] () {
+        double sum = 0.0;
+        for (const auto& v : variants)
+            sum = std::visit([&] (const auto& e) { return e.process(sum); }, v)*0.5;
+        cpputils::benchmark::do_not_optimize(sum);
+    });
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,84 @@
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdlib>
+#include <cstdint>
+#include <typeinfo>
+#include <iostream>
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+#include <cxxabi.h>
+
+#include <cpputils/type_name.hpp>
+#include "benchmark.hpp"
+
+namespace app {
+    struct order {};
+    struct trade {};
+    struct quote {};
+    template<typename T> struct batch {};
+}
+
+using types = cpputils::type_list<app::order, app::trade, app::quote, app::batch<app::order>, app::batch<app::quote>>;
+
+// the baseline: names from RTTI, demangled (and hashed) at runtime
+template<typename T>
+std::string demangled_name() {
+    int status = 0;
+    std::unique_ptr<char, void(*)(void*)> name{abi::__cxa_demangle(typeid(T).name(), nullptr, nullptr, &status), std::free};
+    return status == 0 ? std::string{name.get()} : std::string{typeid(T).name()};
+}
+
+int main() {
+    constexpr std::size_t repetitions = 200000;
+    using table = cpputils::type_names<types>;
+
+    std::cout << "Obtaining the name and identifier of " << types::size << " types" << std::endl;
+    cpputils::benchmark::measure("typeid + __cxa_demangle + std::hash", repetitions*types::size, [&] () {
+        for (std::size_t r = 0; r < repetitions; ++r)
+            [] <typename... Ts> (const cpputils::type_list<Ts...>&) {
+                (..., cpputils::benchmark::do_not_optimize(std::hash<std::string>{}(demangled_name<Ts>())));
+            }(types{});
+    });
+    cpputils::benchmark::measure("type_name + type_id", repetitions*types::size, [&] () {
+        for (std::size_t r = 0; r < repetitions; ++r)
+            [] <typename... Ts> (const cpputils::type_list<Ts...>&) {
+                (..., cpputils::benchmark::do_not_optimize(cpputils::type_name<Ts>().data()));
+                (..., cpputils::benchmark::do_not_optimize(cpputils::type_id<Ts>()));
+            }(types{});
+    });
+
+    std::vector<std::string> names;
+    for (std::size_t i = 0; i < table::size; ++i)
+        names.emplace_back(table::name(i));
+    names.emplace_back("app::unknown");
+    std::unordered_map<std::string_view, std::size_t> map;
+    for (std::size_t i = 0; i < table::size; ++i)
+        map.emplace(table::name(i), i);
+
+    std::cout << "Looking up the index of a type by its (runtime) name" << std::endl;
+    cpputils::benchmark::measure("unordered_map<string_view, size_t>", repetitions*names.size(), [&] () {
+        for (std::size_t r = 0; r < repetitions; ++r)
+            for (const auto& name : names) {
+                const auto it = map.find(name);
+                cpputils::benchmark::do_not_optimize(it == map.end() ? table::size : it->second);
+            }
+    });
+    cpputils::benchmark::measure("type_names::index_of", repetitions*names.size(), [&] () {
+        for (std::size_t r = 0; r < repetitions; ++r)
+            for (const auto& name : names)
+                cpputils::benchmark::do_not_optimize(table::index_of(name).value_or(table::size));
+    });
+
+    std::vector<std::uint64_t> ids{table::ids.begin(), table::ids.end()};
+    ids.push_back(cpputils::fnv1a_hash("app::unknown"));
+    std::cout << "Looking up the index of a type by its (runtime) identifier" << std::endl;
+    cpputils::benchmark::measure("type_names::index_of_id", repetitions*ids.size(), [&] () {
+        for (std::size_t r = 0; r < repetitions; ++r)
+            for (const auto id : ids)
+                cpputils::benchmark::do_not_optimize(table::index_of_id(id).value_or(table::size));
+    });
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,67 @@
+#include <array>
+#include <vector>
+#include <random>
+#include <cstdlib>
+#include <unordered_map>
+
+#include <cpputils/utility.hpp>
+#include "benchmark.hpp"
+
+template<std::size_t n>
+void run() {
+    static constexpr auto key = [] (std::size_t i) constexpr { return static_cast<unsigned>(i*7919 + i*i%101); };
+    static constexpr auto keys = [] <std::size_t... i> (const std::index_sequence<i...>&) {
+        return cpputils::values<key(i)...>{};
+    }(std::make_index_sequence<n>{});
+    static constexpr std::array<unsigned, n> key_array = [] () {
+        std::array<unsigned, n> result{};
+        for (std::size_t i = 0; i < n; ++i)
+            result[i] = key(i);
+        return result;
+    }();
+    const std::unordered_map<unsigned, std::size_t> map = [] () {
+        std::unordered_map<unsigned, std::size_t> result;
+        for (std::size_t i = 0; i < n; ++i)
+            result.emplace(key(i), i);
+        return result;
+    }();
+
+    // half of the queries hit a key, the other half miss
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<std::size_t> distribution{0, n - 1};
+    std::vector<unsigned> queries(1 << 20);
+    for (std::size_t i = 0; i < queries.size(); ++i)
+        queries[i] = key(distribution(generator)) + (i%2);
+
+    std::cout << "Looking up " << queries.size() << " keys in a set of " << n << " keys" << std::endl;
+    cpputils::benchmark::measure("values::index_of (perfect hash)", queries.size(), [&] () {
+        std::size_t sum = 0;
+        for (auto q : queries)
+            sum += keys.index_of(q).value_or(0);
+        cpputils::benchmark::do_not_optimize(sum);
+    });
+    cpputils::benchmark::measure("linear search over std::array", queries.size(), [&] () {
+        std::size_t sum = 0;
+        for (auto q : queries)
+            for (std::size_t i = 0; i < n; ++i)
+                if (key_array[i] == q) {
+                    sum += i;
+                    break;
+                }
+        cpputils::benchmark::do_not_optimize(sum);
+    });
+    cpputils::benchmark::measure("std::unordered_map::find", queries.size(), [&] () {
+        std::size_t sum = 0;
+        for (auto q : queries)
+            if (auto it = map.find(q); it != map.end())
+                sum += it->second;
+        cpputils::benchmark::do_not_optimize(sum);
+    });
+}
+
+int main() {
+    run<8>();
+    run<64>();
+    run<512>();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,66 @@
+#include <random>
+#include <vector>
+#include <variant>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#include <cpputils/variant.hpp>
+#include "benchmark.hpp"
+
+template<std::size_t i>
+struct element {
+    std::uint32_t value;
+    std::uint64_t operator()(std::uint64_t x) const { return x*(i + 1) + value; }
+};
+
+template<std::size_t n>
+void run() {
+    using std_variant = decltype([] <std::size_t... i> (const std::index_sequence<i...>&) {
+        return std::variant<element<i>...>{};
+    }(std::make_index_sequence<n>{}));
+    using variant = decltype([] <std::size_t... i> (const std::index_sequence<i...>&) {
+        return cpputils::variant<element<i>...>{};
+    }(std::make_index_sequence<n>{}));
+
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<std::size_t> distribution{0, n - 1};
+    std::vector<std_variant> std_variants(1 << 20);
+    std::vector<variant> variants(std_variants.size());
+    for (std::size_t k = 0; k < variants.size(); ++k)
+        cpputils::with_index<n>(distribution(generator), [&] (auto i) {
+            std_variants[k] = element<i.value>{static_cast<std::uint32_t>(i.value)};
+            variants[k] = element<i.value>{static_cast<std::uint32_t>(i.value)};
+        });
+
+    std::cout << "Visiting " << variants.size() << " variants with " << n << " alternatives ("
+              << "sizeof(std::variant) = " << sizeof(std_variant) << ", "
+              << "sizeof(cpputils::variant) = " << sizeof(variant) << ")" << std::endl;
+    cpputils::benchmark::measure("std::visit on std::variant", variants.size(), [&] () {
+        std::uint64_t sum = 0;
+        for (const auto& v : std_variants)
+            sum += std::visit([&] (const auto& e) { return e(sum); }, v);
+        cpputils::benchmark::do_not_optimize(sum);
+    });
+    cpputils::benchmark::measure("cpputils::variant::visit", variants.size(), [&] () {
+        std::uint64_t sum = 0;
+        for (const auto& v : variants)
+            sum += v.visit([&] (const auto& e) { return e(sum); });
+        cpputils::benchmark::do_not_optimize(sum);
+    });
+    cpputils::benchmark::measure("copy std::vector<std::variant>", variants.size(), [&] () {
+        auto copy = std_variants;
+        cpputils::benchmark::do_not_optimize(copy.data());
+    });
+    cpputils::benchmark::measure("copy std::vector<cpputils::variant>", variants.size(), [&] () {
+        auto copy = variants;
+        cpputils::benchmark::do_not_optimize(copy.data());
+    });
+}
+
+int main() {
+    run<8>();
+    run<64>();
+    run<256>();
+    return EXIT_SUCCESS;
+}
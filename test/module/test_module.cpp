@@ -0,0 +1,22 @@
+#include <cstdlib>
+
+import cpputils;
+
+struct tag {};
+
+int main() {
+    static_assert(cpputils::values<3, 1, 2>::sort() == cpputils::values<1, 2, 3>{});
+    static_assert(cpputils::are_unique_v<int, double, tag>);
+    static_assert(cpputils::type_name<tag>() == "tag");
+
+    cpputils::indexed_tuple tuple{1, 2.0};
+    int sum = 0;
+    cpputils::for_each(tuple, [&] (const auto& value) { sum += static_cast<int>(value); });
+
+    // uses threads, which the module target links
+    cpputils::thread_pool pool{2};
+    cpputils::type_metrics<tag> metrics;
+    cpputils::parallel_for_each(tuple, [&] (const auto&) { metrics.record<tag>(); }, pool);
+
+    return sum == 3 and metrics.statistics<tag>().count == 2 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
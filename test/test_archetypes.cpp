@@ -0,0 +1,134 @@
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <stdexcept>
+#include <type_traits>
+
+#include <boost/ut.hpp>
+
+#include <cpputils/archetypes.hpp>
+
+struct position { float x, y, z; };
+struct velocity { float x, y, z; };
+struct health { int value; };
+struct name { std::string value; };
+struct frozen {};
+
+using registry = cpputils::archetype_registry<
+    cpputils::archetype<position, velocity>,
+    cpputils::archetype<position, velocity, health>,
+    cpputils::archetype<velocity, position, frozen>,
+    cpputils::archetype<position, name>,
+    cpputils::archetype<velocity, position, velocity>  // same as the first one
+>;
+
+int main() {
+    using boost::ut::operator""_test;
+    using boost::ut::expect;
+    using boost::ut::eq;
+    using boost::ut::throws;
+    using cpputils::archetype;
+    using cpputils::type_list;
+
+    "archetype_registry_canonical_archetypes"_test = [] () {
+        static_assert(std::is_same_v<registry::archetypes, type_list<
+            type_list<position, velocity>,
+            type_list<position, velocity, health>,
+            type_list<position, velocity, frozen>,
+            type_list<position, name>
+        >>);
+        static_assert(registry::index_of<archetype<velocity, position>>().value == 0);
+        static_assert(registry::index_of<archetype<name, position>>().value == 3);
+        static_assert(registry::chunk_capacity<archetype<position, velocity>> == 16*1024/(2*sizeof(position)));
+    };
+
+    "archetype_registry_queries"_test = [] () {
+        using cpputils::with_components;
+        using cpputils::without_components;
+        static_assert(std::is_same_v<registry::matching_t<with_components<velocity>, without_components<frozen>>, type_list<
+            type_list<position, velocity>,
+            type_list<position, velocity, health>
+        >>);
+        static_assert(std::is_same_v<registry::matching_t<with_components<position, health>>, type_list<
+            type_list<position, velocity, health>
+        >>);
+        static_assert(std::is_same_v<registry::matching_t<with_components<name, health>>, type_list<>>);
+    };
+
+    "archetype_registry_create_and_get"_test = [] () {
+        registry r;
+        const auto moving = r.create(velocity{1, 0, 0}, position{0, 0, 0});
+        const auto named = r.create(position{1, 2, 3}, name{"abc"});
+        expect(eq(moving.archetype_index, std::size_t{0}));
+        expect(eq(named.archetype_index, std::size_t{3}));
+        expect(eq(r.size(), std::size_t{2}));
+        expect(eq(r.size<archetype<position, name>>(), std::size_t{1}));
+
+        expect(eq(r.get<velocity>(moving).x, 1.0f));
+        expect(eq(r.get<name>(named).value, std::string{"abc"}));
+        expect(r.get_if<name>(moving) == nullptr);
+        expect(throws<std::out_of_range>([&] () { static_cast<void>(r.get<health>(named)); }));
+
+        const registry& view = r;
+        static_assert(std::is_same_v<decltype(view.get<velocity>(moving)), const velocity&>);
+        static_assert(std::is_same_v<decltype(view.get_if<velocity>(moving)), const velocity*>);
+        static_assert(std::is_same_v<decltype(r.get_if<velocity>(moving)), velocity*>);
+        r.get<velocity>(moving).x = 2.0f;
+        expect(eq(view.get<velocity>(moving).x, 2.0f));
+        expect(view.get_if<name>(moving) == nullptr);
+    };
+
+    "archetype_registry_single_archetype"_test = [] () {
+        cpputils::archetype_registry<archetype<position, velocity>> r;
+        const auto e = r.create(velocity{1, 0, 0}, position{0, 1, 0});
+        expect(eq(e.archetype_index, std::size_t{0}));
+        expect(eq(r.get<position>(e).y, 1.0f));
+        expect(eq(r.size(), std::size_t{1}));
+    };
+
+    "archetype_registry_for_each"_test = [] () {
+        registry r;
+        const std::size_t count = 2*registry::chunk_capacity<archetype<position, velocity>> + 1;
+        for (std::size_t i = 0; i < count; ++i) {
+            r.create(position{0, 0, 0}, velocity{1, 2, 3});
+            r.create(position{0, 0, 0}, velocity{1, 2, 3}, frozen{});
+        }
+        r.create(position{0, 0, 0}, velocity{1, 2, 3}, health{10});
+        expect(eq(r.chunk_count<archetype<position, velocity>>(), std::size_t{3}));
+
+        std::size_t chunks = 0;
+        r.for_each_chunk<cpputils::with_components<position, velocity>, cpputils::without_components<frozen>>(
+            [&] (std::span<position> positions, std::span<velocity> velocities) {
+                ++chunks;
+                for (std::size_t i = 0; i < positions.size(); ++i)
+                    positions[i].x += velocities[i].x;
+            }
+        );
+        expect(eq(chunks, std::size_t{4}));
+
+        std::size_t moved = 0, not_moved = 0;
+        r.for_each<cpputils::with_components<position>>([&] (const position& p) {
+            ++(p.x == 1.0f ? moved : not_moved);
+        });
+        expect(eq(moved, count + 1));
+        expect(eq(not_moved, count));
+    };
+
+    "archetype_registry_destroy"_test = [] () {
+        registry r;
+        const auto first = r.create(position{1, 0, 0}, name{"first"});
+        r.create(position{2, 0, 0}, name{"second"});
+        r.create(position{3, 0, 0}, name{"third"});
+        r.destroy(first);
+        expect(eq(r.size(), std::size_t{2}));
+
+        // the last entity takes the place of the destroyed one
+        expect(eq(r.get<name>(first).value, std::string{"third"}));
+        std::vector<std::string> names;
+        r.for_each<cpputils::with_components<name>>([&] (const name& n) { names.push_back(n.value); });
+        expect(eq(names.size(), std::size_t{2}));
+        expect(eq(names[1], std::string{"second"}));
+    };
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,134 @@
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+#include <type_traits>
+
+#include <boost/ut.hpp>
+
+#include <cpputils/channels.hpp>
+
+struct tick { int value; };
+struct text { std::string value; };
+
+int main() {
+    using boost::ut::operator""_test;
+    using boost::ut::expect;
+    using boost::ut::eq;
+
+    "typed_channels_push_and_pop"_test = [] () {
+        cpputils::typed_channels<tick, text> channels{3};
+        expect(eq(channels.capacity_per_type(), std::size_t{4}));
+        static_assert(decltype(channels)::index_of<text>().value == 1);
+
+        for (int i = 0; i < 4; ++i)
+            expect(channels.try_push(tick{i}));
+        expect(!channels.try_push(tick{4}));
+        expect(channels.try_push(text{"abc"}));
+        expect(eq(channels.size<tick>(), std::size_t{4}));
+
+        for (int i = 0; i < 4; ++i)
+            expect(eq(channels.try_pop<tick>()->value, i));
+        expect(!channels.try_pop<tick>().has_value());
+        expect(eq(channels.try_pop<text>()->value, std::string{"abc"}));
+
+        // the buffers wrap around
+        for (int i = 0; i < 10; ++i) {
+            channels.push(tick{i});
+            expect(eq(channels.try_pop<tick>()->value, i));
+        }
+    };
+
+    "typed_channels_poll_round_robin"_test = [] () {
+        cpputils::typed_channels<tick, text> channels;
+        for (int i = 0; i < 2; ++i) {
+            channels.push(tick{i});
+            channels.push(text{std::to_string(i)});
+        }
+        std::string order;
+        while (channels.poll([&] <typename T> (T&& message) {
+            if constexpr (std::is_same_v<T, tick>)
+                order += "t" + std::to_string(message.value);
+            else
+                order += "s" + message.value;
+        })) {}
+        expect(eq(order, std::string{"t0s0t1s1"}));
+    };
+
+    "typed_channels_poll_cursor_per_channel"_test = [] () {
+        cpputils::typed_channels<tick, text> first, second;
+        for (int i = 0; i < 2; ++i) {
+            first.push(tick{i});
+            first.push(text{std::to_string(i)});
+            second.push(tick{i});
+            second.push(text{std::to_string(i)});
+        }
+        std::string order;
+        const auto append = [&] <typename T> (T&& message) {
+            if constexpr (std::is_same_v<T, tick>)
+                order += "t" + std::to_string(message.value);
+            else
+                order += "s" + message.value;
+        };
+        // the channels do not advance each other's cursor
+        while (first.poll(append) | second.poll(append)) {}
+        expect(eq(order, std::string{"t0t0s0s0t1t1s1s1"}));
+
+        // actions of different types share the cursor of a channel
+        order.clear();
+        for (int i = 0; i < 2; ++i) {
+            first.push(tick{i});
+            first.push(text{std::to_string(i)});
+        }
+        while (first.poll(append) | first.poll([&] (auto&& message) { append(std::move(message)); })) {}
+        expect(eq(order, std::string{"t0s0t1s1"}));
+    };
+
+    "typed_channels_leftover_messages_are_destroyed"_test = [] () {
+        cpputils::typed_channels<text> channels{4};
+        channels.push(text{std::string(100, 'a')});
+        channels.push(text{std::string(100, 'b')});
+    };
+
+    "typed_channels_concurrent_consumers"_test = [] () {
+        constexpr int count = 20000;
+        cpputils::typed_channels<tick, text> channels{64};
+        std::atomic<long long> sum = 0;
+        std::atomic<int> received = 0;
+        std::atomic<bool> done = false;
+        {
+            std::vector<std::jthread> consumers;
+            for (int t = 0; t < 4; ++t)
+                consumers.emplace_back([&] () {
+                    const auto handle = [&] <typename T> (T&& message) {
+                        if constexpr (std::is_same_v<T, tick>)
+                            sum += message.value;
+                        else
+                            sum += std::stoi(message.value);
+                        ++received;
+                    };
+                    while (true) {
+                        if (channels.poll(handle))
+                            continue;
+                        if (done.load())
+                            if (!channels.poll(handle))
+                                break;
+                        std::this_thread::yield();
+                    }
+                });
+            std::jthread text_producer{[&] () {
+                for (int i = 0; i < count; ++i)
+                    channels.push(text{std::to_string(i)});
+            }};
+            for (int i = 0; i < count; ++i)
+                channels.push(tick{i});
+            text_producer.join();
+            done = true;
+        }
+        expect(eq(received.load(), 2*count));
+        expect(eq(sum.load(), 2*static_cast<long long>(count)*(count - 1)/2));
+    };
+
+    return EXIT_SUCCESS;
+}
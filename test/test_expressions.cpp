@@ -0,0 +1,114 @@
+#include <array>
+#include <vector>
+#include <numeric>
+#include <cstdlib>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+#include <boost/ut.hpp>
+
+#include <cpputils/expressions.hpp>
+#include <cpputils/parallel.hpp>
+
+// executor without size() that fails to submit all but the first task
+struct failing_executor {
+    cpputils::thread_pool& pool;
+    std::size_t submitted = 0;
+
+    void execute(std::function<void()> task) {
+        if (submitted++ > 0)
+            throw std::runtime_error("executor is full");
+        pool.execute(std::move(task));
+    }
+};
+
+int main() {
+    using boost::ut::operator""_test;
+    using boost::ut::expect;
+    using boost::ut::throws;
+    using boost::ut::eq;
+
+    "expression_elements"_test = [] () {
+        static constexpr std::array a{1, 2, 3};
+        static constexpr std::array b{4.0, 5.0, 6.0};
+        constexpr auto e = cpputils::lazy(a)*b + 1;
+        static_assert(e.size() == 3);
+        static_assert(std::is_same_v<decltype(e)::value_type, double>);
+        static_assert(e[0] == 5.0 and e[2] == 19.0);
+        static_assert((2*cpputils::lazy(a) - a/cpputils::lazy(a))[1] == 3);
+        static_assert((-cpputils::lazy(a))[2] == -3);
+        static_assert(!cpputils::is_expression_v<std::array<int, 3>>);
+    };
+
+    "expression_borrows_lvalues_and_owns_temporaries"_test = [] () {
+        std::vector<double> a{1.0, 2.0, 3.0};
+        const auto borrowed = cpputils::lazy(a);
+        const auto owned = cpputils::lazy(std::vector<double>{10.0, 20.0, 30.0});
+        const auto sum = borrowed + owned;
+        a[1] = 5.0;
+        expect(eq(cpputils::evaluate(sum), std::vector<double>{11.0, 25.0, 33.0}));
+
+        // temporary sub-expressions are moved into the enclosing expression
+        const auto nested = (cpputils::lazy(std::vector<int>{1, 2}) + 1)*cpputils::lazy(std::vector<int>{3, 4});
+        expect(eq(cpputils::evaluate(nested), std::vector<int>{6, 12}));
+    };
+
+    "expression_size_mismatch"_test = [] () {
+        const std::vector<int> a(3), b(4);
+        expect(throws<std::invalid_argument>([&] () { static_cast<void>(cpputils::lazy(a) + cpputils::lazy(b)); }));
+        std::vector<int> out(2);
+        expect(throws<std::invalid_argument>([&] () { cpputils::evaluate(cpputils::lazy(a) + 1, out); }));
+    };
+
+    "expression_over_indexed_tuple_fields"_test = [] () {
+        cpputils::indexed_tuple fields{std::vector<float>(5, 2.0f), std::vector<int>(5, 3), std::vector<double>(5, 1.0)};
+        const auto lazy = cpputils::lazy_fields(fields);
+        const auto& a = lazy.get(cpputils::ic<0>);
+        const auto& b = lazy.get(cpputils::ic<1>);
+        const auto& c = lazy.get(cpputils::ic<2>);
+
+        // evaluating into one of the operands is fine, as every element only depends on the same index
+        cpputils::evaluate(a*b + c, fields.get(cpputils::ic<2>));
+        expect(eq(fields.get(cpputils::ic<2>), std::vector<double>(5, 7.0)));
+    };
+
+    "expression_parallel_evaluation"_test = [] () {
+        const std::size_t size = 1000003;
+        std::vector<double> a(size), b(size);
+        std::iota(a.begin(), a.end(), 0.0);
+        std::iota(b.rbegin(), b.rend(), 0.0);
+        const auto e = cpputils::lazy(a)*2.0 + b;
+
+        cpputils::thread_pool pool{3};
+        const auto result = cpputils::evaluate(e, pool);
+        expect(eq(result.size(), size));
+        bool all_equal = true;
+        for (std::size_t i = 0; i < size; ++i)
+            all_equal &= result[i] == static_cast<double>(size - 1 + i);
+        expect(all_equal);
+        expect(eq(cpputils::evaluate(e), result));
+
+        std::vector<double> small(10);
+        cpputils::evaluate(cpputils::lazy(small) + 1.0, small, pool);
+        expect(eq(small, std::vector<double>(10, 1.0)));
+    };
+
+    "expression_parallel_evaluation_with_failing_executor"_test = [] () {
+        const std::size_t size = 1000003;
+        std::vector<double> a(size, 1.0), out(size);
+        cpputils::thread_pool pool{3};
+        failing_executor executor{pool};
+        static_assert(cpputils::executor<failing_executor> and !cpputils::sized_executor<failing_executor>);
+        static_assert(cpputils::sized_executor<cpputils::thread_pool>);
+
+        expect(throws<std::runtime_error>([&] () { cpputils::evaluate(cpputils::lazy(a) + 1.0, out, executor, 3); }));
+        expect(eq(executor.submitted, std::size_t{2}));
+        expect(eq(out, std::vector<double>(size, 2.0)));
+
+        executor.submitted = 0;
+        expect(eq(cpputils::evaluate(cpputils::lazy(a)*3.0, executor, 1), std::vector<double>(size, 3.0)));
+    };
+
+    return EXIT_SUCCESS;
+}
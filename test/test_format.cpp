@@ -0,0 +1,32 @@
+#include <cstdio>
+#include <string>
+#include <cstdlib>
+
+#include <boost/ut.hpp>
+
+#include <cpputils/format.hpp>
+
+int main() {
+#if defined(__cpp_lib_format)
+    using boost::ut::operator""_test;
+    using boost::ut::expect;
+    using boost::ut::eq;
+
+    "format_values"_test = [] () {
+        expect(eq(std::format("{}", cpputils::values<1, 2, 3>{}), std::string{"1, 2, 3"}));
+        expect(eq(std::format("[{}]", cpputils::values<'a', false, 0.5>{}), std::string{"[a, false, 0.5]"}));
+        expect(eq(std::format("{}", cpputils::values<>{}), std::string{}));
+    };
+
+    "format_indexed_tuple"_test = [] () {
+        const cpputils::indexed_tuple tuple{1, std::string{"abc"}, 2.5};
+        expect(eq(std::format("{}", tuple), std::string{"(1, abc, 2.5)"}));
+        expect(eq(std::format("{}", cpputils::packed_indexed_tuple{char{'x'}, 42}), std::string{"(x, 42)"}));
+    };
+    return EXIT_SUCCESS;
+#else
+    // reported as skipped by ctest (see SKIP_RETURN_CODE in CMakeLists.txt)
+    std::puts("skipped: the standard library does not provide <format>");
+    return 77;
+#endif
+}
@@ -0,0 +1,184 @@
+#include <set>
+#include <thread>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+#include <memory_resource>
+
+#include <boost/ut.hpp>
+
+#include <cpputils/memory.hpp>
+
+struct small { std::uint8_t value; };
+struct medium { double values[4]; };
+struct alignas(32) aligned { float values[8]; };
+
+// forwards to the default resource and records the sizes of the allocations
+struct recording_resource : std::pmr::memory_resource {
+    std::vector<std::size_t> sizes;
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        sizes.push_back(bytes);
+        return std::pmr::get_default_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        std::pmr::get_default_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+template<typename T>
+bool is_aligned(const T* p, std::size_t alignment) {
+    return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+int main() {
+    using boost::ut::operator""_test;
+    using boost::ut::expect;
+    using boost::ut::eq;
+    using boost::ut::throws;
+
+    "arena_allocate"_test = [] () {
+        cpputils::arena arena{64};
+        void* first = arena.allocate(1, 1);
+        void* second = arena.allocate(8, 8);
+        expect(eq(static_cast<std::byte*>(second) - static_cast<std::byte*>(first), std::ptrdiff_t{8}));
+        expect(is_aligned(arena.allocate(3, 32), 32));
+
+        // exceeding the block size requests a new (larger) block
+        void* large = arena.allocate(1000);
+        expect(is_aligned(large, alignof(std::max_align_t)));
+        arena.deallocate(large, 1000);
+        arena.release();
+    };
+
+    "arena_release_resets_block_size"_test = [] () {
+        recording_resource upstream;
+        cpputils::arena arena{64, &upstream};
+        while (upstream.sizes.size() < 3)
+            static_cast<void>(arena.allocate(60, 1));
+        expect(upstream.sizes[1] > upstream.sizes[0] and upstream.sizes[2] > upstream.sizes[1]);
+
+        // a reused arena starts over with blocks of the initial size
+        arena.release();
+        static_cast<void>(arena.allocate(60, 1));
+        expect(eq(upstream.sizes.back(), upstream.sizes.front()));
+    };
+
+    "arena_with_initial_buffer"_test = [] () {
+        alignas(std::max_align_t) std::byte buffer[256];
+        cpputils::arena arena{buffer};
+        std::pmr::vector<int> values{&arena};
+        values.reserve(16);
+        expect(reinterpret_cast<std::byte*>(values.data()) >= buffer);
+        expect(reinterpret_cast<std::byte*>(values.data()) < buffer + sizeof(buffer));
+        for (int i = 0; i < 1000; ++i)
+            values.push_back(i);
+        expect(eq(values[999], 999));
+    };
+
+    "pool_reuses_blocks"_test = [] () {
+        cpputils::pool<24, 8> pool{4};
+        static_assert(decltype(pool)::stride == 24);
+        std::set<void*> blocks;
+        for (int i = 0; i < 10; ++i)
+            blocks.insert(pool.allocate());
+        expect(eq(blocks.size(), std::size_t{10}));
+        for (void* block : blocks)
+            expect(is_aligned(block, 8));
+
+        void* freed = *blocks.begin();
+        pool.deallocate(freed);
+        expect(eq(pool.allocate(), freed));
+
+        std::pmr::memory_resource& resource = pool;
+        expect(throws<std::bad_alloc>([&] () { static_cast<void>(resource.allocate(25, 8)); }));
+    };
+
+    "typed_pools_allocate"_test = [] () {
+        cpputils::typed_pools<small, medium, aligned> pools{2};
+        static_assert(decltype(pools)::index_of<medium>().value == 1);
+
+        std::vector<medium*> objects;
+        for (int i = 0; i < 100; ++i)
+            objects.push_back(pools.create<medium>(medium{{double(i), 0.0, 0.0, 0.0}}));
+        for (int i = 0; i < 100; ++i)
+            expect(eq(objects[i]->values[0], double(i)));
+        for (medium* object : objects)
+            pools.destroy(object);
+
+        aligned* a = pools.allocate<aligned>();
+        expect(is_aligned(a, 32));
+        pools.deallocate(a);
+    };
+
+    "typed_pools_as_memory_resource"_test = [] () {
+        cpputils::typed_pools<small, medium, std::string> pools;
+        std::pmr::vector<std::pmr::string> strings{&pools};
+        for (int i = 0; i < 100; ++i)
+            strings.emplace_back(std::string(100, 'a'));
+        expect(eq(strings[99].size(), std::size_t{100}));
+
+        // requests are served by the smallest pool that fits
+        std::pmr::memory_resource& resource = pools;
+        void* p = resource.allocate(2, 1);
+        void* q = resource.allocate(2, 1);
+        resource.deallocate(q, 2, 1);
+        expect(eq(resource.allocate(2, 1), q));
+        resource.deallocate(p, 2, 1);
+    };
+
+    "typed_pools_interleaved_instances"_test = [] () {
+        cpputils::typed_pools<small, medium> first, second;
+        std::vector<medium*> from_first, from_second;
+        for (int i = 0; i < 100; ++i) {
+            from_first.push_back(first.create<medium>(medium{{1.0, 0.0, 0.0, 0.0}}));
+            from_second.push_back(second.create<medium>(medium{{2.0, 0.0, 0.0, 0.0}}));
+        }
+        for (int i = 0; i < 100; ++i) {
+            expect(eq(from_first[i]->values[0], 1.0));
+            expect(eq(from_second[i]->values[0], 2.0));
+            first.destroy(from_first[i]);
+            second.destroy(from_second[i]);
+        }
+    };
+
+    "typed_pools_concurrent"_test = [] () {
+        cpputils::typed_pools<small, medium> pools;
+        std::vector<std::vector<medium*>> allocated(4);
+        {
+            std::vector<std::jthread> threads;
+            for (std::size_t t = 0; t < allocated.size(); ++t)
+                threads.emplace_back([&, t] () {
+                    for (int i = 0; i < 1000; ++i)
+                        allocated[t].push_back(pools.create<medium>(medium{{double(t), 0.0, 0.0, 0.0}}));
+                    for (int i = 0; i < 500; ++i)
+                        pools.destroy(pools.create<small>(small{1}));
+                });
+        }
+        std::set<medium*> unique;
+        for (std::size_t t = 0; t < allocated.size(); ++t)
+            for (medium* object : allocated[t]) {
+                expect(eq(object->values[0], double(t)));
+                unique.insert(object);
+            }
+        expect(eq(unique.size(), std::size_t{4000}));
+
+        // deallocate from other threads than the allocating ones
+        {
+            std::vector<std::jthread> threads;
+            for (std::size_t t = 0; t < allocated.size(); ++t)
+                threads.emplace_back([&, t] () {
+                    for (medium* object : allocated[(t + 1) % allocated.size()])
+                        pools.destroy(object);
+                });
+        }
+    };
+
+    return EXIT_SUCCESS;
+}
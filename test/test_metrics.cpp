@@ -0,0 +1,138 @@
+#include <array>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+
+#include <boost/ut.hpp>
+
+#include <cpputils/metrics.hpp>
+#include <cpputils/serialization.hpp>
+
+struct parse {};
+struct route {};
+struct store {};
+
+int main() {
+    using boost::ut::operator""_test;
+    using boost::ut::expect;
+    using boost::ut::eq;
+    using namespace std::chrono_literals;
+
+    "type_statistics_histogram"_test = [] () {
+        static_assert(cpputils::type_statistics::bucket_of(0) == 0);
+        static_assert(cpputils::type_statistics::bucket_of(1) == 1);
+        static_assert(cpputils::type_statistics::bucket_of(1000) == 10);
+        static_assert(cpputils::type_statistics::bucket_of(~std::uint64_t{0}) == 47);
+
+        cpputils::type_metrics<parse> metrics;
+        for (int i = 0; i < 98; ++i)
+            metrics.record<parse>(100ns);
+        metrics.record<parse>(5000ns);
+        metrics.record<parse>(7000ns);
+        const auto statistics = metrics.statistics<parse>();
+        expect(eq(statistics.count, std::uint64_t{100}));
+        expect(eq(statistics.total_ns, std::uint64_t{98*100 + 12000}));
+        expect(eq(statistics.min_ns, std::uint64_t{100}));
+        expect(eq(statistics.max_ns, std::uint64_t{7000}));
+        expect(eq(statistics.histogram[7], std::uint64_t{98}));
+        expect(eq(statistics.histogram[13], std::uint64_t{2}));
+        expect(eq(statistics.mean_ns(), 218.0));
+        expect(eq(statistics.quantile_ns(0.5), std::uint64_t{127}));
+        expect(eq(statistics.quantile_ns(0.99), std::uint64_t{7000}));
+    };
+
+    "type_metrics_per_type"_test = [] () {
+        cpputils::type_metrics<parse, route, store> metrics;
+        static_assert(decltype(metrics)::index_of<store>().value == 2);
+        metrics.record<route>(10ns);
+        metrics.record<route>(30ns);
+        {
+            const auto timer = metrics.measure<store>();
+            std::this_thread::sleep_for(1ms);
+        }
+        const auto snapshot = metrics.snapshot();
+        expect(eq(snapshot[0].count, std::uint64_t{0}));
+        expect(eq(snapshot[1].count, std::uint64_t{2}));
+        expect(eq(snapshot[1].min_ns, std::uint64_t{10}));
+        expect(eq(snapshot[1].max_ns, std::uint64_t{30}));
+        expect(eq(snapshot[2].count, std::uint64_t{1}));
+        expect(snapshot[2].min_ns >= std::uint64_t{1000000});
+        expect(snapshot[2] == metrics.statistics<store>());
+    };
+
+    "type_metrics_negative_duration"_test = [] () {
+        cpputils::type_metrics<parse> metrics;
+        metrics.record<parse>(-5ns);
+        metrics.record<parse>(20ns);
+        const auto statistics = metrics.statistics<parse>();
+        expect(eq(statistics.count, std::uint64_t{2}));
+        expect(eq(statistics.total_ns, std::uint64_t{20}));
+        expect(eq(statistics.min_ns, std::uint64_t{0}));
+        expect(eq(statistics.max_ns, std::uint64_t{20}));
+        expect(eq(statistics.histogram[0], std::uint64_t{1}));
+    };
+
+    "type_metrics_merges_threads"_test = [] () {
+        cpputils::type_metrics<parse, route> metrics;
+        {
+            std::vector<std::jthread> threads;
+            for (int t = 0; t < 4; ++t)
+                threads.emplace_back([&, t] () {
+                    for (int i = 0; i < 1000; ++i) {
+                        metrics.record<parse>(std::chrono::nanoseconds{t + 1});
+                        const auto timer = metrics.measure<route>();
+                    }
+                    // concurrent reads see partial (but valid) statistics
+                    expect(metrics.statistics<parse>().count >= std::uint64_t{1000});
+                });
+        }
+        const auto snapshot = metrics.snapshot();
+        expect(eq(snapshot[0].count, std::uint64_t{4000}));
+        expect(eq(snapshot[0].total_ns, std::uint64_t{10000}));
+        expect(eq(snapshot[0].min_ns, std::uint64_t{1}));
+        expect(eq(snapshot[0].max_ns, std::uint64_t{4}));
+        expect(eq(snapshot[1].count, std::uint64_t{4000}));
+    };
+
+    "type_metrics_interleaved_instances"_test = [] () {
+        cpputils::type_metrics<parse, route> first, second;
+        for (int i = 0; i < 10; ++i) {
+            first.record<parse>(1ns);
+            second.record<parse>(2ns);
+            second.record<route>(3ns);
+        }
+        expect(eq(first.statistics<parse>().total_ns, std::uint64_t{10}));
+        expect(eq(first.statistics<route>().count, std::uint64_t{0}));
+        expect(eq(second.statistics<parse>().total_ns, std::uint64_t{20}));
+        expect(eq(second.statistics<route>().total_ns, std::uint64_t{30}));
+    };
+
+    "type_metrics_json"_test = [] () {
+        cpputils::type_metrics<parse, route> metrics;
+        metrics.record<route>(10ns);
+        metrics.record<route>(20ns);
+        std::string json;
+        cpputils::write_json(metrics.snapshot(), std::back_inserter(json));
+        expect(eq(json, std::string{
+            "[{\"index\":0,\"count\":0,\"total_ns\":0,\"min_ns\":0,\"max_ns\":0,\"histogram\":[]},"
+            "{\"index\":1,\"count\":2,\"total_ns\":30,\"min_ns\":10,\"max_ns\":20,\"histogram\":[0,0,0,0,1,1]}]"
+        }));
+    };
+
+    "type_metrics_binary_snapshot"_test = [] () {
+        cpputils::type_metrics<parse, route> metrics;
+        metrics.record<parse>(42ns);
+        const auto snapshot = metrics.snapshot();
+        std::vector<std::byte> buffer(cpputils::serialized_size(snapshot));
+        cpputils::serialize(snapshot, buffer);
+        decltype(metrics)::snapshot_type read;
+        cpputils::deserialize(read, buffer);
+        expect(read == snapshot);
+    };
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,112 @@
+#include <array>
+#include <vector>
+#include <numeric>
+#include <cstdlib>
+#include <functional>
+
+#include <boost/ut.hpp>
+
+#include <cpputils/utility.hpp>
+#include <cpputils/numeric.hpp>
+
+int main() {
+    using boost::ut::operator""_test;
+    using boost::ut::expect;
+    using boost::ut::eq;
+
+    "sum"_test = [] () {
+        static_assert(cpputils::sum(std::array{1, 2, 3}) == 6);
+        static_assert(cpputils::sum(std::array<int, 0>{}) == 0);
+
+        std::vector<double> v(37);
+        std::iota(v.begin(), v.end(), 1.0);
+        expect(eq(cpputils::sum(v), 37.0*38.0/2.0));
+    };
+
+    "min_max"_test = [] () {
+        static_assert(cpputils::min(std::array{3, -1, 2}) == -1);
+        static_assert(cpputils::max(std::array{3, -1, 2}) == 3);
+
+        std::vector<int> v(101);
+        std::iota(v.begin(), v.end(), -50);
+        v[42] = 1000;
+        v[87] = -1000;
+        expect(eq(cpputils::min(v), -1000));
+        expect(eq(cpputils::max(v), 1000));
+        expect(eq(cpputils::min(std::vector{7}), 7));
+    };
+
+    "dot"_test = [] () {
+        static_assert(cpputils::dot(std::array{1, 2, 3}, std::array{4, 5, 6}) == 32);
+
+        std::vector<double> a(19, 2.0);
+        std::vector<int> b(19, 3);
+        expect(eq(cpputils::dot(a, b), 19*6.0));
+    };
+
+    "inclusive_scan"_test = [] () {
+        std::vector<int> v(17, 1);
+        std::vector<int> result(17);
+        cpputils::inclusive_scan(v, result);
+        for (std::size_t i = 0; i < result.size(); ++i)
+            expect(eq(result[i], static_cast<int>(i + 1)));
+
+        cpputils::inclusive_scan(std::array{1, 2, 3}, result);
+        expect(eq(result[2], 6));
+    };
+
+    "values_as_array"_test = [] () {
+        using weights = cpputils::values<1.0, 4.0, 1.0>;
+        static_assert(weights::as_array().size() == 3);
+        static_assert(weights::as_array()[1] == 4.0);
+        static_assert(cpputils::sum(weights::as_array()) == 6.0);
+
+        std::vector<double> x{1.0, 2.0, 3.0};
+        expect(eq(cpputils::dot(weights::as_array(), x), 12.0));
+    };
+
+    "values_reduce_with"_test = [] () {
+        using list = cpputils::values<1, 2, 3>;
+        static_assert(list::reduce_with(std::plus{}, 0) == 6);
+        static_assert(list::reduce_with([] (double sum, int v) { return sum + v/2.0; }, 0.0) == 3.0);
+        static_assert(cpputils::values<>::reduce_with(std::plus{}, 42) == 42);
+
+        // the type of the intermediate result may change between steps
+        constexpr auto count = cpputils::values<1, 'a', 2u>::reduce_with([] (auto n, auto) { return n + 1; }, 0);
+        static_assert(count == 3);
+
+        constexpr auto large = [] <std::size_t... i> (const std::index_sequence<i...>&) {
+            return cpputils::values<i...>::reduce_with(std::plus{}, std::size_t{0});
+        }(std::make_index_sequence<2000>{});
+        static_assert(large == 2000*1999/2);
+    };
+
+    "stencil_apply"_test = [] () {
+        std::vector<double> x(10);
+        for (std::size_t i = 0; i < x.size(); ++i)
+            x[i] = static_cast<double>(i*i);
+
+        // second derivative of i^2 is 2 in the interior, the boundary is left untouched
+        std::vector<double> result(10, -1.0);
+        cpputils::stencil_apply(cpputils::values<-1, 0, 1>{}, cpputils::values<1.0, -2.0, 1.0>{}, x, result);
+        expect(eq(result[0], -1.0));
+        expect(eq(result[9], -1.0));
+        for (std::size_t i = 1; i < 9; ++i)
+            expect(eq(result[i], 2.0));
+
+        // one-sided stencils
+        std::array<int, 5> y{1, 2, 4, 8, 16};
+        std::array<int, 5> forward{};
+        cpputils::stencil_apply(cpputils::values<0, 2>{}, cpputils::values<-1, 1>{}, y, forward);
+        expect(eq(forward[0], 3));
+        expect(eq(forward[2], 12));
+        expect(eq(forward[3], 0));
+
+        std::array<int, 5> backward{};
+        cpputils::stencil_apply(cpputils::values<-1>{}, cpputils::values<2>{}, y, backward);
+        expect(eq(backward[0], 0));
+        expect(eq(backward[4], 16));
+    };
+
+    return EXIT_SUCCESS;
+}
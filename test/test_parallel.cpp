@@ -0,0 +1,76 @@
+#include <latch>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <string>
+#include <cstdlib>
+#include <stdexcept>
+
+#include <boost/ut.hpp>
+
+#include <cpputils/parallel.hpp>
+
+int main() {
+    using boost::ut::operator""_test;
+    using boost::ut::expect;
+    using boost::ut::eq;
+    using boost::ut::throws;
+    using cpputils::ic;
+
+    "thread_pool_execute"_test = [] () {
+        std::atomic<int> count = 0;
+        {
+            cpputils::thread_pool pool{2};
+            expect(eq(pool.size(), std::size_t{2}));
+            for (int i = 0; i < 100; ++i)
+                pool.execute([&] () { ++count; });
+        }
+        expect(eq(count.load(), 100));
+    };
+
+    "parallel_for_each_with_pool"_test = [] () {
+        std::vector<int> v(1000, 1);
+        cpputils::indexed_tuple tuple{v, std::vector<double>(1000, 1.0), std::string{"abc"}};
+
+        // each element waits for all others, which only succeeds if they are processed concurrently
+        std::latch all_started{3};
+        cpputils::thread_pool pool{2};
+        cpputils::parallel_for_each(tuple, [&] (auto& element) {
+            all_started.arrive_and_wait();
+            for (auto& value : element)
+                value += 1;
+        }, pool);
+
+        expect(eq(v[999], 2));
+        expect(eq(tuple.get(ic<1>)[999], 2.0));
+        expect(eq(tuple.get(ic<2>), std::string{"bcd"}));
+    };
+
+    "parallel_for_each_with_threads"_test = [] () {
+        cpputils::indexed_tuple tuple{int{1}, double{2.0}, char{'a'}};
+        std::latch all_started{3};
+        cpputils::parallel_for_each(tuple, [&] (auto& element) {
+            all_started.arrive_and_wait();
+            element += 1;
+        });
+        expect(eq(tuple.get(ic<0>), 2));
+        expect(eq(tuple.get(ic<1>), 3.0));
+        expect(eq(tuple.get(ic<2>), 'b'));
+    };
+
+    "parallel_for_each_exception"_test = [] () {
+        cpputils::indexed_tuple tuple{int{1}, double{2.0}};
+        cpputils::thread_pool pool{1};
+        expect(throws([&] () {
+            cpputils::parallel_for_each(tuple, [] (auto& element) {
+                if constexpr (std::is_same_v<std::remove_cvref_t<decltype(element)>, int>)
+                    throw std::runtime_error("error");
+            }, pool);
+        }));
+        expect(throws([&] () {
+            cpputils::parallel_for_each(tuple, [] (auto&) { throw std::runtime_error("error"); });
+        }));
+    };
+
+    return EXIT_SUCCESS;
+}
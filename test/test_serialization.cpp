@@ -0,0 +1,166 @@
+#include <array>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+
+#include <boost/ut.hpp>
+
+#include <cpputils/serialization.hpp>
+
+struct point {
+    double x;
+    double y;
+};
+
+struct other_point {
+    float x;
+    float y;
+    float z;
+    float w;
+};
+
+struct int_and_float {
+    int i;
+    float f;
+};
+
+struct float_and_int {
+    float f;
+    int i;
+};
+
+int main() {
+    using boost::ut::operator""_test;
+    using boost::ut::expect;
+    using boost::ut::eq;
+    using boost::ut::throws;
+    using cpputils::ic;
+
+    "trivially_copyable_tuple"_test = [] () {
+        using record = cpputils::indexed_tuple<int, double, point>;
+        const record written{42, 3.5, point{1.0, 2.0}};
+        expect(eq(cpputils::serialized_size(written), sizeof(std::uint64_t) + sizeof(record)));
+
+        std::array<std::byte, 128> buffer;
+        const std::size_t size = cpputils::serialize(written, buffer);
+        expect(eq(size, cpputils::serialized_size(written)));
+
+        record read{0, 0.0, point{}};
+        expect(eq(cpputils::deserialize(read, std::span{buffer}.first(size)), size));
+        expect(eq(read.get(ic<0>), 42));
+        expect(eq(read.get(ic<1>), 3.5));
+        expect(eq(read.get(ic<2>).y, 2.0));
+    };
+
+    "element_wise_tuple"_test = [] () {
+        using record = cpputils::indexed_tuple<int, std::string, std::vector<double>, std::vector<std::string>>;
+        const record written{7, std::string{"hello"}, std::vector{1.0, 2.0}, std::vector<std::string>{"a", "bc"}};
+
+        std::vector<std::byte> buffer(cpputils::serialized_size(written));
+        expect(eq(cpputils::serialize(written, buffer), buffer.size()));
+
+        record read{0, std::string{}, std::vector<double>{}, std::vector<std::string>{}};
+        expect(eq(cpputils::deserialize(read, buffer), buffer.size()));
+        expect(eq(read.get(ic<0>), 7));
+        expect(eq(read.get(ic<1>), std::string{"hello"}));
+        expect(eq(read.get(ic<2>).size(), std::size_t{2}));
+        expect(eq(read.get(ic<2>)[1], 2.0));
+        expect(eq(read.get(ic<3>)[1], std::string{"bc"}));
+    };
+
+    "sequential_records"_test = [] () {
+        std::vector<std::byte> buffer(1024);
+        std::size_t offset = 0;
+        for (int i = 0; i < 3; ++i)
+            offset += cpputils::serialize(cpputils::indexed_tuple{i, std::string(i, 'x')}, std::span{buffer}.subspan(offset));
+
+        cpputils::indexed_tuple<int, std::string> record{0, std::string{}};
+        std::span<const std::byte> input{buffer.data(), offset};
+        for (int i = 0; i < 3; ++i) {
+            input = input.subspan(cpputils::deserialize(record, input));
+            expect(eq(record.get(ic<0>), i));
+            expect(eq(record.get(ic<1>).size(), static_cast<std::size_t>(i)));
+        }
+        expect(input.empty());
+    };
+
+    "schema_hash"_test = [] () {
+        using cpputils::schema_hash;
+        using cpputils::indexed_tuple;
+        static_assert(schema_hash<int> != schema_hash<float>);
+        static_assert(schema_hash<int> != schema_hash<unsigned int>);
+        static_assert(schema_hash<indexed_tuple<int, float>> != schema_hash<indexed_tuple<float, int>>);
+        static_assert(schema_hash<indexed_tuple<int, float>> == schema_hash<indexed_tuple<int, float>>);
+        // same size, but different storage order
+        using fields = indexed_tuple<std::uint16_t, std::uint32_t, std::int16_t, std::int8_t, std::uint8_t>;
+        using packed_fields = cpputils::packed_indexed_tuple<std::uint16_t, std::uint32_t, std::int16_t, std::int8_t, std::uint8_t>;
+        static_assert(sizeof(fields) == sizeof(packed_fields));
+        static_assert(schema_hash<fields> != schema_hash<packed_fields>);
+        // same layout (equal alignments keep their order)
+        static_assert(schema_hash<indexed_tuple<int, float>> == schema_hash<cpputils::packed_indexed_tuple<int, float>>);
+        // element-wise layout does not depend on the storage order
+        static_assert(schema_hash<indexed_tuple<std::string, int>> == schema_hash<cpputils::packed_indexed_tuple<std::string, int>>);
+        static_assert(schema_hash<std::vector<int>> != schema_hash<std::vector<long long>>);
+        static_assert(schema_hash<point> != schema_hash<other_point>);
+        // same size and alignment, but different members
+        static_assert(schema_hash<int_and_float> != schema_hash<float_and_int>);
+        static_assert(schema_hash<int_and_float> == schema_hash<const int_and_float>);
+        static_assert(schema_hash<cpputils::values<1, 2>> != schema_hash<cpputils::values<1, 3>>);
+        static_assert(schema_hash<cpputils::values<1.0>> != schema_hash<cpputils::values<1.0f>>);
+    };
+
+    "reference_elements"_test = [] () {
+        static_assert(!cpputils::serializable<cpputils::indexed_tuple<int*, double>>);
+        static_assert(cpputils::serializable<cpputils::indexed_tuple<int&, double>>);
+        // references are written element-wise, as the referenced values
+        static_assert(cpputils::schema_hash<cpputils::indexed_tuple<int&, double>> != cpputils::schema_hash<cpputils::indexed_tuple<int, double>>);
+        static_assert(cpputils::schema_hash<cpputils::indexed_tuple<int&, std::string>> == cpputils::schema_hash<cpputils::indexed_tuple<int, std::string>>);
+
+        int a = 1;
+        std::array<std::byte, 64> buffer;
+        const std::size_t size = cpputils::serialize(cpputils::indexed_tuple<int&, double>{a, 2.5}, buffer);
+        expect(eq(size, sizeof(std::uint64_t) + sizeof(int) + sizeof(double)));
+
+        int b = 0;
+        cpputils::indexed_tuple<int&, double> read{b, 0.0};
+        cpputils::deserialize(read, buffer);
+        expect(eq(&read.get(ic<0>), &b));
+        expect(eq(b, 1));
+        expect(eq(a, 1));
+        expect(eq(read.get(ic<1>), 2.5));
+    };
+
+    "schema_mismatch"_test = [] () {
+        std::array<std::byte, 64> buffer;
+        cpputils::serialize(cpputils::indexed_tuple{1, 2.0f}, buffer);
+        cpputils::indexed_tuple<float, int> wrong{0.0f, 0};
+        expect(throws<cpputils::schema_mismatch>([&] () { cpputils::deserialize(wrong, buffer); }));
+
+        cpputils::serialize(cpputils::indexed_tuple<std::uint16_t, std::uint32_t, std::int16_t, std::int8_t, std::uint8_t>{1, 2, 3, 4, 5}, buffer);
+        cpputils::packed_indexed_tuple<std::uint16_t, std::uint32_t, std::int16_t, std::int8_t, std::uint8_t> packed{0, 0, 0, 0, 0};
+        expect(throws<cpputils::schema_mismatch>([&] () { cpputils::deserialize(packed, buffer); }));
+
+        cpputils::serialize(cpputils::values<1, 2, 3>{}, buffer);
+        cpputils::values<1, 2, 3> same;
+        cpputils::values<1, 2, 4> different;
+        expect(eq(cpputils::deserialize(same, buffer), sizeof(std::uint64_t)));
+        expect(throws<cpputils::schema_mismatch>([&] () { cpputils::deserialize(different, buffer); }));
+    };
+
+    "buffer_too_small"_test = [] () {
+        const cpputils::indexed_tuple record{1, std::string{"abc"}};
+        std::vector<std::byte> buffer(cpputils::serialized_size(record));
+        std::array<std::byte, 4> small;
+        expect(throws<std::length_error>([&] () { cpputils::serialize(record, small); }));
+
+        cpputils::serialize(record, buffer);
+        cpputils::indexed_tuple<int, std::string> read{0, std::string{}};
+        expect(throws<std::length_error>([&] () {
+            cpputils::deserialize(read, std::span{buffer}.first(buffer.size() - 1));
+        }));
+    };
+
+    return EXIT_SUCCESS;
+}
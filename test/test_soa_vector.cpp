@@ -0,0 +1,110 @@
+#include <cstdlib>
+#include <string>
+#include <numeric>
+#include <cstdint>
+#include <type_traits>
+
+#include <boost/ut.hpp>
+
+#include <cpputils/soa_vector.hpp>
+
+int main() {
+    using boost::ut::operator""_test;
+    using boost::ut::expect;
+    using boost::ut::eq;
+    using cpputils::ic;
+
+    "soa_vector_push_back"_test = [] () {
+        cpputils::soa_vector<int, double, std::string> v;
+        expect(v.empty());
+        for (int i = 0; i < 100; ++i)
+            v.push_back(i, 0.5*i, std::to_string(i));
+        expect(eq(v.size(), std::size_t{100}));
+        expect(v.capacity() >= 100);
+
+        for (int i = 0; i < 100; ++i) {
+            expect(eq(v.col<int>()[i], i));
+            expect(eq(v.col<double>()[i], 0.5*i));
+            expect(eq(v.col<std::string>()[i], std::to_string(i)));
+        }
+    };
+
+    "soa_vector_column_alignment"_test = [] () {
+        cpputils::soa_vector<char, double, std::uint16_t> v{3};
+        const auto is_aligned = [] (const void* p) {
+            return reinterpret_cast<std::uintptr_t>(p) % decltype(v)::alignment == 0;
+        };
+        expect(is_aligned(v.col<char>().data()));
+        expect(is_aligned(v.col<double>().data()));
+        expect(is_aligned(v.col<std::uint16_t>().data()));
+        expect(eq(v.col<double>()[2], 0.0));
+    };
+
+    "soa_vector_index_access"_test = [] () {
+        cpputils::soa_vector<int, double> v{10};
+        static_assert(decltype(v)::index_of<int>().value == 0);
+        static_assert(decltype(v)::index_of<double>().value == 1);
+        static_assert(std::is_same_v<decltype(v.col(ic<1>)), std::span<double>>);
+
+        std::iota(v.col(ic<0>).begin(), v.col(ic<0>).end(), 0);
+        for (auto& value : v.col<double>())
+            value = 1.5;
+        expect(eq(std::accumulate(v.col<int>().begin(), v.col<int>().end(), 0), 45));
+        expect(eq(std::accumulate(v.col<double>().begin(), v.col<double>().end(), 0.0), 15.0));
+    };
+
+    "soa_vector_row_proxy"_test = [] () {
+        cpputils::soa_vector<int, std::string> v;
+        v.push_back(1, "one");
+        v.emplace_back(2, "two");
+
+        auto row = v[1];
+        expect(eq(row.get<int>(), 2));
+        expect(eq(row.get(ic<1>), std::string{"two"}));
+        row.get<int>() = 42;
+        expect(eq(v.col<int>()[1], 42));
+
+        const auto& const_v = v;
+        static_assert(std::is_same_v<decltype(const_v[0].get<int>()), const int&>);
+        expect(eq(const_v[0].get<std::string>(), std::string{"one"}));
+    };
+
+    "soa_vector_push_back_own_element"_test = [] () {
+        cpputils::soa_vector<std::string> v;
+        v.push_back("some string that does not fit into the small string buffer");
+        for (int i = 0; i < 20; ++i)
+            v.push_back(v[0].get<std::string>());
+        for (const auto& s : v.col<std::string>())
+            expect(eq(s, std::string{"some string that does not fit into the small string buffer"}));
+    };
+
+    "soa_vector_resize_and_pop"_test = [] () {
+        cpputils::soa_vector<int, std::string> v{5};
+        v.resize(2);
+        expect(eq(v.size(), std::size_t{2}));
+        v.pop_back();
+        expect(eq(v.size(), std::size_t{1}));
+        v.clear();
+        expect(v.empty());
+    };
+
+    "soa_vector_copy_and_move"_test = [] () {
+        cpputils::soa_vector<int, std::string> v;
+        v.push_back(1, "one");
+        v.push_back(2, "two");
+
+        auto copy = v;
+        copy[0].get<int>() = 10;
+        expect(eq(v[0].get<int>(), 1));
+        expect(eq(copy[1].get<std::string>(), std::string{"two"}));
+
+        auto moved = std::move(copy);
+        expect(eq(moved.size(), std::size_t{2}));
+        expect(eq(moved[0].get<int>(), 10));
+
+        v = moved;
+        expect(eq(v[0].get<int>(), 10));
+    };
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,68 @@
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <type_traits>
+
+#include <boost/ut.hpp>
+
+#include <cpputils/type_collection.hpp>
+
+struct circle { double radius; };
+struct square { double length; };
+
+int main() {
+    using boost::ut::operator""_test;
+    using boost::ut::expect;
+    using boost::ut::eq;
+
+    "type_collection_insert"_test = [] () {
+        cpputils::type_collection<circle, square> shapes;
+        expect(shapes.empty());
+
+        shapes.insert(circle{1.0});
+        shapes.insert(square{2.0});
+        const circle c{3.0};
+        shapes.insert(c);
+        shapes.emplace<square>(4.0);
+
+        expect(eq(shapes.size(), std::size_t{4}));
+        expect(eq(shapes.size<circle>(), std::size_t{2}));
+        expect(eq(shapes.size<square>(), std::size_t{2}));
+        expect(eq(shapes.segment<circle>()[1].radius, 3.0));
+        expect(eq(shapes.segment<square>()[1].length, 4.0));
+
+        static_assert(decltype(shapes)::index_of<circle>().value == 0);
+        static_assert(decltype(shapes)::index_of<square>().value == 1);
+    };
+
+    "type_collection_for_each"_test = [] () {
+        cpputils::type_collection<int, std::string> collection;
+        collection.insert(1);
+        collection.insert(std::string{"a"});
+        collection.insert(2);
+        collection.insert(std::string{"b"});
+
+        std::string visited;
+        collection.for_each([&] (const auto& value) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(value)>, int>)
+                visited += std::to_string(value);
+            else
+                visited += value;
+        });
+        expect(eq(visited, std::string{"12ab"}));
+
+        collection.for_each([] (auto& value) { value += value; });
+        expect(eq(collection.segment<int>()[1], 4));
+        expect(eq(collection.segment<std::string>()[1], std::string{"bb"}));
+
+        const auto& const_collection = collection;
+        std::size_t count = 0;
+        const_collection.for_each([&] (const auto&) { ++count; });
+        expect(eq(count, std::size_t{4}));
+
+        collection.clear();
+        expect(collection.empty());
+    };
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,69 @@
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <string_view>
+
+#include <boost/ut.hpp>
+
+#include <cpputils/type_name.hpp>
+
+namespace app { struct message {}; template<typename T> struct envelope {}; }
+enum class level { info, error };
+
+int main() {
+    using boost::ut::operator""_test;
+    using boost::ut::expect;
+    using boost::ut::eq;
+    using namespace std::string_view_literals;
+
+    "fixed_string"_test = [] () {
+        constexpr cpputils::fixed_string s{"abc"};
+        static_assert(s.size() == 3);
+        static_assert(s.view() == "abc");
+        static_assert(s.c_str()[3] == '\0');
+        static_assert(s < cpputils::fixed_string{"abd"});
+        static_assert(s.hash() == cpputils::fnv1a_hash("abc"));
+        // reference values of 64-bit FNV-1a
+        static_assert(cpputils::fnv1a_hash("") == 0xcbf29ce484222325ull);
+        static_assert(cpputils::fnv1a_hash("a") == 0xaf63dc4c8601ec8cull);
+        static_assert(cpputils::fnv1a_hash("foobar") == 0x85944171f73967e8ull);
+
+        using names = cpputils::values<cpputils::fixed_string{"bb"}, cpputils::fixed_string{"aa"}>;
+        static_assert(names::at<1>().view() == "aa");
+        static_assert(names::sort() == cpputils::values<cpputils::fixed_string{"aa"}, cpputils::fixed_string{"bb"}>{});
+    };
+
+    "type_name"_test = [] () {
+        static_assert(cpputils::type_name<int>() == "int");
+        static_assert(cpputils::type_name<app::message>() == "app::message");
+        static_assert(cpputils::type_name<app::envelope<level>>() == "app::envelope<level>");
+        static_assert(cpputils::type_name<level>() == "level");
+        static_assert(cpputils::type_id<app::message>() == cpputils::fnv1a_hash("app::message"));
+        static_assert(cpputils::type_id<int>() != cpputils::type_id<unsigned int>());
+        // the spelling of compound types differs between compilers (e.g. "const double*" and "const double *")
+        expect(cpputils::type_name<const double*>().find("double") != std::string_view::npos);
+        expect(eq(std::string{cpputils::type_name<std::string_view>().data()}, std::string{cpputils::type_name<std::string_view>()}));
+    };
+
+    "type_names_table"_test = [] () {
+        using table = cpputils::type_names<cpputils::type_list<int, app::message, level>>;
+        static_assert(table::size == 3);
+        static_assert(table::name(1) == "app::message");
+        static_assert(table::id(2) == cpputils::type_id<level>());
+        static_assert(table::index_of_id(cpputils::type_id<level>()) == 2);
+        static_assert(table::index_of("int") == 0);
+        static_assert(!table::index_of("float").has_value());
+        static_assert(table::name_values::at<1>().view() == "app::message");
+
+        using indexed_table = cpputils::type_names<cpputils::indexed<float, char>>;
+        static_assert(indexed_table::names[0] == "float");
+
+        // runtime lookups
+        const std::vector<std::string> names{"level", "app::message", "unknown"};
+        expect(eq(table::index_of(names[0]).value(), std::size_t{2}));
+        expect(eq(table::index_of(names[1]).value(), std::size_t{1}));
+        expect(!table::index_of(names[2]).has_value());
+    };
+
+    return EXIT_SUCCESS;
+}
@@ -1,5 +1,7 @@
 #include <cstdlib>
 #include <vector>
+#include <cstdint>
+#include <functional>
 #include <type_traits>
 
 #include <cpputils/type_traits.hpp>
@@ -7,6 +9,9 @@
 struct complete {};
 struct incomplete;
 
+template<typename... Ts>
+concept has_duplicate = requires { typename cpputils::first_duplicate_t<Ts...>; };
+
 int main() {
 
     {
@@ -24,6 +29,9 @@ int main() {
         static_assert(cpputils::contains_decayed_v<char, unique>);
         static_assert(cpputils::contains_decayed_v<double, unique>);
         static_assert(cpputils::contains_decayed_v<double, int, char, double>);
+        static_assert(std::is_same_v<unique, cpputils::type_list<int, char, double>>);
+        static_assert(std::is_same_v<cpputils::unique_t<int>, cpputils::type_list<int>>);
+        static_assert(std::is_same_v<cpputils::unique_t<cpputils::type_list<>>, cpputils::type_list<>>);
     }
     {
         static_assert(cpputils::are_unique_v<int, char>);
@@ -33,6 +41,11 @@ int main() {
         using types = cpputils::type_list<int, char, int, double, int, double>;
         static_assert(!cpputils::are_unique_v<types>);
 
+        static_assert(cpputils::are_unique_v<>);
+        static_assert(cpputils::are_unique_v<int>);
+        static_assert(cpputils::are_unique_v<cpputils::type_list<>>);
+        static_assert(!cpputils::are_unique_v<int, char, double, void, double>);
+
         using unique = cpputils::unique_t<types>;
         static_assert(cpputils::are_unique_v<unique>);
         static_assert(unique::size == 3);
@@ -40,12 +53,26 @@ int main() {
         static_assert(cpputils::contains_decayed_v<char, unique>);
         static_assert(cpputils::contains_decayed_v<double, unique>);
     }
+    {
+        static_assert(std::is_same_v<cpputils::first_duplicate_t<int, char, double, char, int>, int>);
+        static_assert(std::is_same_v<cpputils::first_duplicate_t<int, char, double, char>, char>);
+        static_assert(std::is_same_v<cpputils::first_duplicate_t<cpputils::type_list<int[2], void, int[2]>>, int[2]>);
+        static_assert(has_duplicate<int, char, int>);
+        static_assert(!has_duplicate<int, char, double>);
+        static_assert(!has_duplicate<>);
+    }
     {
         using merged = cpputils::merged_t<cpputils::type_list<int>, cpputils::type_list<char, double>>;
         static_assert(merged::size == 3);
         static_assert(cpputils::contains_decayed_v<int, merged>);
         static_assert(cpputils::contains_decayed_v<char, merged>);
         static_assert(cpputils::contains_decayed_v<double, merged>);
+
+        static_assert(std::is_same_v<
+            cpputils::merged_t<cpputils::type_list<int>, cpputils::type_list<>, cpputils::type_list<char, int>>,
+            cpputils::type_list<int, char, int>
+        >);
+        static_assert(std::is_same_v<cpputils::merged_t<cpputils::type_list<>>, cpputils::type_list<>>);
     }
     {
         using unique_merged = cpputils::unique_t<
@@ -64,6 +91,11 @@ int main() {
         static_assert(filtered::size == 2);
         static_assert(cpputils::is_any_of_v<int&, filtered>);
         static_assert(cpputils::is_any_of_v<const double&, filtered>);
+        static_assert(std::is_same_v<filtered, cpputils::type_list<int&, const double&>>);
+
+        using filtered_list = cpputils::filtered_t<std::is_integral, cpputils::type_list<int, double, char>>;
+        static_assert(std::is_same_v<filtered_list, cpputils::type_list<int, char>>);
+        static_assert(std::is_same_v<cpputils::filtered_t<std::is_integral>, cpputils::type_list<>>);
     }
     {
         using never_reference = cpputils::decayed_trait<std::is_lvalue_reference>;
@@ -78,6 +110,63 @@ int main() {
         static_assert(std::is_same_v<cpputils::first_t<list>, char>);
         static_assert(std::is_same_v<cpputils::first_t<char, int, double>, char>);
     }
+    {
+        using list = cpputils::type_list<char, int, double, int, void, int[2]>;
+        static_assert(std::is_same_v<cpputils::type_list_at_t<0, list>, char>);
+        static_assert(std::is_same_v<cpputils::type_list_at_t<1, list>, int>);
+        static_assert(std::is_same_v<cpputils::type_list_at_t<3, list>, int>);
+        static_assert(std::is_same_v<cpputils::type_list_at_t<4, list>, void>);
+        static_assert(std::is_same_v<cpputils::type_list_at_t<5, list>, int[2]>);
+    }
+    {
+        using list = cpputils::type_list<double, char, std::int32_t, char[2], std::int16_t, std::uint32_t>;
+        using by_alignment = cpputils::sorted_t<std::alignment_of, std::less<>, list>;
+        static_assert(std::is_same_v<
+            by_alignment,
+            cpputils::type_list<char, char[2], std::int16_t, std::int32_t, std::uint32_t, double>
+        >);
+        using by_alignment_descending = cpputils::sorted_t<std::alignment_of, std::greater<>, list>;
+        static_assert(std::is_same_v<
+            by_alignment_descending,
+            cpputils::type_list<double, std::int32_t, std::uint32_t, std::int16_t, char, char[2]>
+        >);
+        static_assert(std::is_same_v<cpputils::sorted_t<std::alignment_of, std::less<>>, cpputils::type_list<>>);
+    }
+    {
+        using table = cpputils::trait_table<
+            cpputils::type_list<int, const double&, char*, std::vector<int>>,
+            std::is_integral, std::is_reference, std::is_pointer
+        >;
+        static_assert(table::results.size() == 3);
+        static_assert(table::results[0].size() == 4);
+        static_assert(table::value<std::is_integral, int>());
+        static_assert(!table::value<std::is_integral, const double&>());
+        static_assert(table::value<std::is_reference, const double&>());
+        static_assert(table::value<std::is_pointer, char*>());
+        static_assert(!table::value<std::is_pointer, std::vector<int>>());
+        static_assert(table::count<std::is_integral>() == 1);
+        static_assert(table::count<std::is_pointer>() == 1);
+
+        static_assert(table::index_of<char*>() == 2);
+        static_assert(table::trait_index<std::is_pointer>() == 2);
+        static_assert(table::at(table::trait_index<std::is_reference>(), table::index_of<const double&>()));
+
+        static_assert(table::contains<int>());
+        static_assert(!table::contains<double>());
+        static_assert(table::contains_decayed<double>());
+        static_assert(table::contains_decayed<const std::vector<int>&>());
+        static_assert(!table::contains_decayed<float>());
+
+        // the decayed types of a table may contain duplicates
+        using duplicates = cpputils::trait_table<cpputils::type_list<int, const int&, int&>, std::is_const>;
+        static_assert(duplicates::contains_decayed<int&&>());
+        static_assert(!duplicates::contains_decayed<char>());
+        static_assert(!duplicates::value<std::is_const, const int&>());
+
+        using empty = cpputils::trait_table<cpputils::type_list<>, std::is_integral>;
+        static_assert(!empty::contains<int>());
+        static_assert(empty::count<std::is_integral>() == 0);
+    }
 
     return EXIT_SUCCESS;
 }
@@ -1,11 +1,21 @@
 #include <cstdlib>
+#include <array>
 #include <vector>
+#include <string>
+#include <limits>
+#include <sstream>
+#include <iterator>
+#include <functional>
+#include <stdexcept>
 #include <type_traits>
 
 #include <boost/ut.hpp>
 
 #include <cpputils/utility.hpp>
 
+struct empty_a {};
+struct empty_b {};
+
 int main() {
     using boost::ut::operator""_test;
     using boost::ut::expect;
@@ -34,6 +44,67 @@ int main() {
         expect(eq(&v, &storage.get()));
     };
 
+    "inplace_function_owns_rvalue"_test = [] () {
+        int calls = 0;
+        cpputils::inplace_function<int(int)> f{[&calls, offset = 1] (int i) mutable { ++calls; return i + offset++; }};
+        expect(static_cast<bool>(f));
+        expect(eq(f(1), 2));
+        expect(eq(f(1), 3));
+
+        auto copy = f;
+        expect(eq(copy(1), 4));
+        expect(eq(f(1), 4));
+        expect(eq(calls, 4));
+
+        auto moved = std::move(copy);
+        expect(!static_cast<bool>(copy));
+        expect(eq(moved(1), 5));
+    };
+
+    "inplace_function_borrows_lvalue"_test = [] () {
+        int offset = 0;
+        auto add = [&offset] (int i) { return i + offset; };
+        cpputils::inplace_function<int(int), sizeof(void*)> f{add};
+        offset = 10;
+        expect(eq(f(1), 11));
+        static_assert(!decltype(f)::fits<decltype(std::array<int, 3>{})>);
+    };
+
+    "inplace_function_with_non_trivial_capture"_test = [] () {
+        std::vector<int> values{1, 2, 3};
+        cpputils::inplace_function<std::size_t(), 64> f{[values] () { return values.size(); }};
+        cpputils::inplace_function<std::size_t(), 64> g;
+        expect(!static_cast<bool>(g));
+        g = f;
+        f = {};
+        expect(!static_cast<bool>(f));
+        expect(eq(g(), std::size_t{3}));
+    };
+
+    "function_ref"_test = [] () {
+        int calls = 0;
+        auto increment = [&calls] (int i) { calls += i; };
+        const auto call_twice = [] (cpputils::function_ref<void(int)> f) { f(1); f(2); };
+        call_twice(increment);
+        expect(eq(calls, 3));
+
+        struct helper { static int twice(int i) { return 2*i; } };
+        cpputils::function_ref<int(int)> twice{helper::twice};
+        expect(eq(twice(21), 42));
+
+        // function pointers are referenced by value, also if given as temporaries
+        cpputils::function_ref<int(int)> from_address = &helper::twice;
+        expect(eq(from_address(4), 8));
+        int (*pointer)(int) = &helper::twice;
+        cpputils::function_ref<int(int)> from_pointer{pointer};
+        pointer = nullptr;
+        expect(eq(from_pointer(5), 10));
+
+        cpputils::inplace_function<int(int)> owning{[] (int i) { return i + 1; }};
+        cpputils::function_ref<int(int)> ref{owning};
+        expect(eq(ref(1), 2));
+    };
+
     "indexed"_test = [] () {
         cpputils::indexed<int, char, double> indexed;
         static_assert(indexed.index_of(int{}).value == 0);
@@ -66,6 +137,103 @@ int main() {
         expect(eq(tuple.get(tuple.template index_of<double>()), 12.0));
     };
 
+    "with_index"_test = [] () {
+        static_assert(cpputils::with_index<3>(2, [] (auto i) { return i.value*10; }) == 20);
+        for (std::size_t i = 0; i < 10; ++i)
+            expect(eq(cpputils::with_index<10>(i, [] <std::size_t n> (cpputils::index_constant<n>) { return n; }), i));
+
+        int value = 0;
+        cpputils::with_index<1>(0, [&] (auto i) { value = static_cast<int>(i.value) + 1; });
+        expect(eq(value, 1));
+    };
+
+    "indexed_tuple_empty_elements"_test = [] () {
+        static_assert(sizeof(cpputils::indexed_tuple<int, empty_a, empty_b>) == sizeof(int));
+        static_assert(sizeof(cpputils::indexed_tuple<empty_a, int, empty_b>) == sizeof(int));
+        static_assert(sizeof(cpputils::packed_indexed_tuple<empty_a, int, empty_b>) == sizeof(int));
+        static_assert(std::is_empty_v<cpputils::indexed_tuple<empty_a, empty_b>>);
+
+        cpputils::indexed_tuple tuple{empty_a{}, int{42}, empty_b{}};
+        expect(eq(tuple.get(tuple.template index_of<int>()), 42));
+        static_assert(std::is_same_v<std::remove_cvref_t<decltype(tuple.get(cpputils::ic<0>))>, empty_a>);
+    };
+
+    "packed_indexed_tuple"_test = [] () {
+        static_assert(sizeof(cpputils::indexed_tuple<char, double, bool>) == 3*sizeof(double));
+        static_assert(sizeof(cpputils::packed_indexed_tuple<char, double, bool>) == 2*sizeof(double));
+        static_assert(sizeof(cpputils::packed_indexed_tuple<char, std::uint16_t, bool, std::uint32_t>) == 8);
+
+        int i = 1;
+        cpputils::packed_indexed_tuple tuple{char{'a'}, double{2.0}, i, std::uint16_t{3}};
+        static_assert(tuple.size == 4);
+        static_assert(tuple.template index_of<char>().value == 0);
+        static_assert(tuple.template index_of<double>().value == 1);
+        static_assert(tuple.index_of(i).value == 2);
+        static_assert(tuple.template index_of<std::uint16_t>().value == 3);
+        expect(eq(tuple.get(cpputils::ic<0>), 'a'));
+        expect(eq(tuple.get(cpputils::ic<1>), 2.0));
+        expect(eq(&tuple.get(cpputils::ic<2>), &i));
+        expect(eq(tuple.get(cpputils::ic<3>), std::uint16_t{3}));
+        expect(eq(cpputils::visit(tuple, 1, [] (const auto& e) { return sizeof(e); }), sizeof(double)));
+
+        tuple.get(cpputils::ic<1>) = 4.0;
+        expect(eq(tuple.get(cpputils::ic<1>), 4.0));
+    };
+
+    "indexed_tuple_visit"_test = [] () {
+        std::vector<int> v{1, 2};
+        cpputils::indexed_tuple tuple{int{42}, char{'K'}, v};
+        static_assert(tuple.size == 3);
+        static_assert(cpputils::is_indexed_tuple_v<decltype(tuple)>);
+        static_assert(!cpputils::is_indexed_tuple_v<int>);
+
+        const auto size_of = [] (const auto& element) { return sizeof(element); };
+        expect(eq(cpputils::visit(tuple, 0, size_of), sizeof(int)));
+        expect(eq(cpputils::visit(tuple, 1, size_of), sizeof(char)));
+        expect(eq(cpputils::visit(tuple, 2, size_of), sizeof(std::vector<int>)));
+
+        cpputils::visit(tuple, 2, [] (auto& element) {
+            if constexpr (std::is_same_v<std::remove_cvref_t<decltype(element)>, std::vector<int>>)
+                element.push_back(3);
+        });
+        expect(eq(v.size(), std::size_t{3}));
+
+        const auto& const_tuple = tuple;
+        expect(eq(cpputils::visit(const_tuple, 1, size_of), sizeof(char)));
+    };
+
+    "indexed_tuple_for_each"_test = [] () {
+        std::vector<int> v{1, 2};
+        cpputils::indexed_tuple tuple{int{42}, double{1.0}, v};
+        std::size_t bytes = 0;
+        cpputils::for_each(tuple, [&] (const auto& element) { bytes += sizeof(element); });
+        expect(eq(bytes, sizeof(int) + sizeof(double) + sizeof(std::vector<int>)));
+
+        cpputils::for_each(tuple, [] (auto& element) {
+            if constexpr (std::is_arithmetic_v<std::remove_cvref_t<decltype(element)>>)
+                element *= 2;
+            else
+                element.push_back(3);
+        });
+        expect(eq(tuple.get(cpputils::ic<0>), 84));
+        expect(eq(tuple.get(cpputils::ic<1>), 2.0));
+        expect(eq(v.size(), std::size_t{3}));
+    };
+
+    "indexed_tuple_transform"_test = [] () {
+        constexpr cpputils::indexed_tuple tuple{int{42}, char{'K'}, double{1.0}};
+        constexpr auto transformed = cpputils::transform(tuple, [] (const auto& element) {
+            return std::array<std::remove_cvref_t<decltype(element)>, 2>{element, element};
+        });
+        static_assert(std::is_same_v<
+            std::remove_cvref_t<decltype(transformed)>,
+            cpputils::indexed_tuple<std::array<int, 2>, std::array<char, 2>, std::array<double, 2>>
+        >);
+        static_assert(transformed.get(cpputils::ic<0>)[1] == 42);
+        static_assert(transformed.get(cpputils::ic<1>)[1] == 'K');
+        static_assert(transformed.get(cpputils::ic<2>)[1] == 1.0);
+    };
+
     "value_list_access"_test = [] () {
         constexpr cpputils::values<0, 1, 2> values;
         static_assert(values.at(ic<0>) == 0);
@@ -74,6 +242,32 @@ int main() {
 
         static_assert(values.first() == 0);
         static_assert(values.last() == 2);
+
+        static_assert(values.template at<0>() == 0);
+        static_assert(values.template at<1>() == 1);
+        static_assert(values.template at<2>() == 2);
+    };
+
+    "value_list_access_mixed_types"_test = [] () {
+        constexpr cpputils::values<0, 'a', 2.0, 0> values;
+        static_assert(values.template at<0>() == 0);
+        static_assert(values.template at<1>() == 'a');
+        static_assert(values.template at<2>() == 2.0);
+        static_assert(values.template at<3>() == 0);
+        static_assert(std::is_same_v<decltype(values.template at<1>()), char>);
+        static_assert(std::is_same_v<
+            std::remove_cvref_t<decltype(values.template drop<1>())>,
+            cpputils::values<'a', 2.0, 0>
+        >);
+    };
+
+    "value_list_access_large"_test = [] () {
+        constexpr auto values = [] <std::size_t... i> (const std::index_sequence<i...>&) {
+            return cpputils::values<i...>{};
+        }(std::make_index_sequence<2000>{});
+        static_assert(values.template at<1234>() == 1234);
+        static_assert(values.last() == 1999);
+        static_assert(values.template drop<1990>() == cpputils::values<1990, 1991, 1992, 1993, 1994, 1995, 1996, 1997, 1998, 1999>{});
     };
 
     "value_list_drop_n"_test = [] () {
@@ -115,6 +309,128 @@ int main() {
         std::ostringstream s;
         s << cpputils::values<0, 1, 2>{};
         expect(eq(s.str(), std::string{"0, 1, 2"}));
+
+        enum class id : std::uint8_t { a = 3, b = 200 };
+        s.str({});
+        s << cpputils::values<-1, 'x', true, 2.5, id::b, 7u>{};
+        expect(eq(s.str(), std::string{"-1, x, true, 2.5, 200, 7"}));
+
+        s.str({});
+        s << cpputils::values<>{};
+        expect(eq(s.str(), std::string{}));
+    };
+
+    "value_list_to_chars"_test = [] () {
+        using list = cpputils::values<10, -20, 30>;
+        char buffer[16];
+        const auto result = list::to_chars(buffer, buffer + 16);
+        expect(result.ec == std::errc{});
+        expect(eq(std::string(buffer, result.ptr), std::string{"10, -20, 30"}));
+
+        expect(list::to_chars(buffer, buffer + 10).ec == std::errc::value_too_large);
+        expect(list::to_chars(buffer, buffer + 3).ec == std::errc::value_too_large);
+        expect(list::to_chars(buffer, buffer + 2).ec == std::errc::value_too_large);
+
+        std::string text;
+        list::write_to(std::back_inserter(text));
+        expect(eq(text, std::string{"10, -20, 30"}));
+
+        text.clear();
+        cpputils::values<>::write_to(std::back_inserter(text));
+        expect(eq(text, std::string{}));
+        expect(cpputils::values<>::to_chars(buffer, buffer).ptr == buffer);
+
+        text.clear();
+        cpputils::values<std::numeric_limits<long double>::lowest(), std::numeric_limits<long long>::min()>::write_to(
+            std::back_inserter(text)
+        );
+        expect(eq(text.substr(text.find(", ")), std::string{", -9223372036854775808"}));
+
+        using characters = cpputils::values<'a', true, false>;
+        const auto written = characters::to_chars(buffer, buffer + 16);
+        expect(eq(std::string(buffer, written.ptr), std::string{"a, true, false"}));
+        expect(characters::to_chars(buffer, buffer + 8).ec == std::errc::value_too_large);
+    };
+
+    "value_list_index_of"_test = [] () {
+        constexpr cpputils::values<42, 7, -3, 1000, 7> values;
+        static_assert(values.index_of(42) == 0);
+        static_assert(values.index_of(7) == 1);
+        static_assert(values.index_of(-3) == 2);
+        static_assert(values.index_of(1000) == 3);
+        static_assert(!values.index_of(0).has_value());
+        static_assert(!cpputils::values<>::index_of(0).has_value());
+
+        int key = 1000;
+        expect(eq(values.index_of(key).value(), std::size_t{3}));
+        expect(!values.index_of(key + 1).has_value());
+    };
+
+    "value_list_index_of_enum"_test = [] () {
+        enum class id : std::uint8_t { a = 3, b = 1, c = 255 };
+        constexpr cpputils::values<id::a, id::b, id::c> values;
+        static_assert(values.index_of(id::a) == 0);
+        static_assert(values.index_of(id::b) == 1);
+        static_assert(values.index_of(id::c) == 2);
+        static_assert(!values.index_of(id{0}).has_value());
+    };
+
+    "value_list_index_of_large"_test = [] () {
+        constexpr auto values = [] <std::size_t... i> (const std::index_sequence<i...>&) {
+            return cpputils::values<(i*7919 + i*i%101)...>{};
+        }(std::make_index_sequence<1000>{});
+        constexpr bool all_found = [&] <std::size_t... i> (const std::index_sequence<i...>&) {
+            return ((values.index_of(i*7919 + i*i%101) == i) && ...);
+        }(std::make_index_sequence<1000>{});
+        static_assert(all_found);
+        for (std::size_t i = 0; i < 1000; ++i)
+            expect(!values.index_of(i*7919 + 1000).has_value());
+    };
+
+    "value_list_sort"_test = [] () {
+        constexpr cpputils::values<3, 1, 2, 1, 0> values;
+        static_assert(values.sort() == cpputils::values<0, 1, 1, 2, 3>{});
+        static_assert(values.sort<std::greater<>>() == cpputils::values<3, 2, 1, 1, 0>{});
+        static_assert(values.sort_unique() == cpputils::values<0, 1, 2, 3>{});
+        static_assert(cpputils::values<>::sort() == cpputils::values<>{});
+
+        enum class id { a, b, c };
+        static_assert(cpputils::values<id::c, id::a, id::b>::sort() == cpputils::values<id::a, id::b, id::c>{});
+    };
+
+    "value_list_set_operations"_test = [] () {
+        constexpr cpputils::values<5, 1, 3, 3> a;
+        constexpr cpputils::values<4, 3, 5, 2> b;
+        static_assert(cpputils::set_union(a, b) == cpputils::values<1, 2, 3, 4, 5>{});
+        static_assert(cpputils::set_intersection(a, b) == cpputils::values<3, 5>{});
+        static_assert(cpputils::set_difference(a, b) == cpputils::values<1>{});
+        static_assert(cpputils::set_difference(b, a) == cpputils::values<2, 4>{});
+        static_assert(cpputils::set_union(a, cpputils::values<>{}) == cpputils::values<1, 3, 5>{});
+        static_assert(cpputils::set_intersection(cpputils::values<>{}, b) == cpputils::values<>{});
+    };
+
+    "static_for"_test = [] () {
+        std::vector<std::size_t> visited;
+        cpputils::static_for<4>([&] (auto i) {
+            static_assert(std::is_same_v<decltype(i), cpputils::index_constant<i.value>>);
+            visited.push_back(i.value);
+        });
+        expect(eq(visited.size(), std::size_t{4}));
+        expect(eq(visited[3], std::size_t{3}));
+        cpputils::static_for<0>([] (auto) { throw std::runtime_error("unexpected"); });
+    };
+
+    "unrolled_for"_test = [] () {
+        constexpr int sum_of_weighted = [] () {
+            int sum = 0;
+            cpputils::unrolled_for(cpputils::values<5, 6, 7>{}, [&] (auto i, int value) { sum += static_cast<int>(i.value)*value; });
+            return sum;
+        }();
+        static_assert(sum_of_weighted == 6 + 14);
+
+        std::size_t count = 0;
+        cpputils::unrolled_for(cpputils::values<1, 'a', true>{}, [&] (auto, auto) { ++count; });
+        expect(eq(count, std::size_t{3}));
     };
 
     "value_list_reduce"_test = [] () {
@@ -0,0 +1,149 @@
+#include <string>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <type_traits>
+
+#include <boost/ut.hpp>
+
+#include <cpputils/variant.hpp>
+
+struct throws_on_copy {
+    throws_on_copy() = default;
+    throws_on_copy(const throws_on_copy&) { throw std::runtime_error{"copy"}; }
+    throws_on_copy& operator=(const throws_on_copy&) = default;
+};
+
+struct throws_on_move {
+    throws_on_move() = default;
+    throws_on_move(const throws_on_move&) = default;
+    throws_on_move(throws_on_move&&) { throw std::runtime_error{"move"}; }
+    throws_on_move& operator=(const throws_on_move&) = default;
+};
+
+template<std::size_t i>
+struct alternative {};
+
+int main() {
+    using boost::ut::operator""_test;
+    using boost::ut::expect;
+    using boost::ut::eq;
+    using boost::ut::throws;
+
+    "variant_construct_and_get"_test = [] () {
+        cpputils::variant<int, double, std::string> v;
+        expect(eq(v.index(), std::size_t{0}));
+        expect(eq(v.get<int>(), 0));
+
+        v = std::string{"abc"};
+        expect(v.holds<std::string>());
+        expect(eq(v.get<std::string>(), std::string{"abc"}));
+        expect(v.get_if<int>() == nullptr);
+        expect(throws<cpputils::bad_variant_access>([&] () { static_cast<void>(v.get<double>()); }));
+
+        const double d = 1.5;
+        v = d;
+        expect(eq(v.index(), std::size_t{1}));
+        expect(eq(*v.get_if<double>(), 1.5));
+
+        v.emplace<std::string>(3, 'x');
+        expect(eq(v.get<std::string>(), std::string{"xxx"}));
+
+        cpputils::variant<int, std::string> in_place{std::in_place_type<std::string>, "abc"};
+        expect(eq(std::move(in_place).get<std::string>(), std::string{"abc"}));
+
+        static_assert(decltype(v)::index_of<std::string>().value == 2);
+    };
+
+    "variant_visit"_test = [] () {
+        cpputils::variant<int, std::string> v{std::string{"abc"}};
+        const auto size = [] <typename T> (const T& value) -> std::size_t {
+            if constexpr (std::is_same_v<T, int>)
+                return sizeof(int);
+            else
+                return value.size();
+        };
+        expect(eq(cpputils::visit(v, size), std::size_t{3}));
+        v = 42;
+        expect(eq(v.visit(size), sizeof(int)));
+
+        v.visit([] (auto& value) { value += value; });
+        expect(eq(v.get<int>(), 84));
+    };
+
+    "variant_copy_and_move"_test = [] () {
+        cpputils::variant<int, std::vector<int>> v{std::vector<int>{1, 2, 3}};
+        auto copy = v;
+        expect(eq(copy.get<std::vector<int>>().size(), std::size_t{3}));
+        expect(copy == v);
+
+        auto moved = std::move(copy);
+        expect(eq(moved.get<std::vector<int>>().size(), std::size_t{3}));
+
+        copy = 1;
+        expect(!(copy == v));
+        v = copy;
+        expect(eq(v.get<int>(), 1));
+    };
+
+    "variant_is_trivial_for_trivial_alternatives"_test = [] () {
+        using trivial = cpputils::variant<int, double, char>;
+        static_assert(std::is_trivially_copyable_v<trivial>);
+        static_assert(std::is_trivially_destructible_v<trivial>);
+        static_assert(sizeof(trivial) == 2*sizeof(double));
+        static_assert(!std::is_trivially_copyable_v<cpputils::variant<int, std::string>>);
+        static_assert(!std::is_copy_constructible_v<cpputils::variant<int, std::unique_ptr<int>>>);
+    };
+
+    "variant_smallest_index_type"_test = [] () {
+        using small = decltype([] <std::size_t... i> (const std::index_sequence<i...>&) {
+            return cpputils::variant<alternative<i>...>{};
+        }(std::make_index_sequence<255>{}));
+        using large = decltype([] <std::size_t... i> (const std::index_sequence<i...>&) {
+            return cpputils::variant<alternative<i>...>{};
+        }(std::make_index_sequence<256>{}));
+        static_assert(std::is_same_v<small::index_type, std::uint8_t>);
+        static_assert(std::is_same_v<large::index_type, std::uint16_t>);
+
+        large v{alternative<200>{}};
+        expect(eq(v.index(), std::size_t{200}));
+        expect(eq(v.visit([] <std::size_t i> (const alternative<i>&) { return i; }), std::size_t{200}));
+    };
+
+    "variant_self_assignment"_test = [] () {
+        cpputils::variant<int, std::string> v{std::string(100, 'a')};
+        v = v.get<std::string>();
+        expect(eq(v.get<std::string>(), std::string(100, 'a')));
+        v = std::string(50, 'b');
+        expect(eq(v.get<std::string>(), std::string(50, 'b')));
+
+        // the new alternative is constructed from the old one before that is destroyed
+        cpputils::variant<std::string, std::vector<std::string>> w{std::string(100, 'c')};
+        w.emplace<std::vector<std::string>>(2, w.get<std::string>());
+        expect(eq(w.get<std::vector<std::string>>()[1], std::string(100, 'c')));
+        w.emplace<std::string>(w.get<std::vector<std::string>>()[0]);
+        expect(eq(w.get<std::string>(), std::string(100, 'c')));
+    };
+
+    "variant_keeps_value_if_construction_throws"_test = [] () {
+        cpputils::variant<int, throws_on_copy> v{42};
+        const throws_on_copy value;
+        expect(throws<std::runtime_error>([&] () { v = value; }));
+        expect(eq(v.get<int>(), 42));
+    };
+
+    "variant_valueless_by_exception"_test = [] () {
+        cpputils::variant<int, throws_on_move> v;
+        const throws_on_move value;
+        expect(throws<std::runtime_error>([&] () { v = value; }));
+        expect(v.valueless_by_exception());
+        expect(eq(v.index(), decltype(v)::npos));
+        expect(throws<cpputils::bad_variant_access>([&] () { v.visit([] (auto&) {}); }));
+        v = 1;
+        expect(eq(v.get<int>(), 1));
+    };
+
+    return EXIT_SUCCESS;
+}